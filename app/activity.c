@@ -0,0 +1,82 @@
+#include <activity.h>
+#include <profile.h>
+
+// Callbacks only set a bit, the task turns whatever gathered since the last pulse
+// into a single pulse, an error wins over radio traffic which wins over host traffic
+static struct
+{
+    bc_led_t *led;
+    bool enabled;
+    bool planned;
+    uint8_t pending;
+    bc_tick_t next;
+    bc_scheduler_task_id_t task_id;
+
+} _activity;
+
+static void _activity_task(void *param);
+
+void activity_init(bc_led_t *led)
+{
+    memset(&_activity, 0, sizeof(_activity));
+
+    _activity.led = led;
+    _activity.enabled = true;
+
+    _activity.task_id = PROFILE_REGISTER(_activity_task, NULL, BC_TICK_INFINITY);
+}
+
+void activity_signal(activity_t activity)
+{
+    _activity.pending |= 1 << activity;
+
+    if (!_activity.planned && _activity.enabled)
+    {
+        _activity.planned = true;
+
+        bc_scheduler_plan_absolute(_activity.task_id, _activity.next);
+    }
+}
+
+void activity_set_enabled(bool enabled)
+{
+    _activity.enabled = enabled;
+    _activity.pending = 0;
+}
+
+static void _activity_task(void *param)
+{
+    (void) param;
+
+    if (!_activity.enabled || (_activity.pending == 0))
+    {
+        _activity.planned = false;
+
+        return;
+    }
+
+    // A longer pulse (attach, button) is not cut short
+    if (bc_led_is_pulse(_activity.led))
+    {
+        bc_scheduler_plan_current_relative(ACTIVITY_INTERVAL);
+
+        return;
+    }
+
+    bc_tick_t duration = ACTIVITY_TX_PULSE;
+
+    if (_activity.pending & (1 << ACTIVITY_ERROR))
+    {
+        duration = ACTIVITY_ERROR_PULSE;
+    }
+    else if (_activity.pending & (1 << ACTIVITY_RX))
+    {
+        duration = ACTIVITY_RX_PULSE;
+    }
+
+    bc_led_pulse(_activity.led, duration);
+
+    _activity.pending = 0;
+    _activity.planned = false;
+    _activity.next = bc_tick_get() + duration + ACTIVITY_INTERVAL;
+}
@@ -0,0 +1,28 @@
+#ifndef _ACTIVITY_H
+#define _ACTIVITY_H
+
+#include <bc_common.h>
+#include <bc_led.h>
+
+#define ACTIVITY_INTERVAL 100
+#define ACTIVITY_RX_PULSE 10
+#define ACTIVITY_TX_PULSE 3
+#define ACTIVITY_ERROR_PULSE 250
+
+typedef enum
+{
+    ACTIVITY_RX = 0,
+    ACTIVITY_TX = 1,
+    ACTIVITY_ERROR = 2
+
+} activity_t;
+
+void activity_init(bc_led_t *led);
+
+// Only marks the activity, the LED is updated at most once per ACTIVITY_INTERVAL
+void activity_signal(activity_t activity);
+
+// Disabled while the LED shows something else, pairing mode or the state set by the host
+void activity_set_enabled(bool enabled);
+
+#endif
@@ -0,0 +1,418 @@
+#include <alias.h>
+#include <usb_talk.h>
+#include <storage.h>
+#include <bcl.h>
+
+#define ALIAS_MAGIC 0xa1a5
+#define ALIAS_VERSION 1
+
+typedef struct
+{
+    uint16_t magic;
+    uint8_t version;
+    uint8_t reserved[5];
+
+} alias_header_t;
+
+typedef struct
+{
+    uint64_t id;
+    char name[ALIAS_NAME_LENGTH];
+
+} alias_record_t;
+
+#define ALIAS_RECORD_ADDRESS(slot) (ALIAS_EEPROM_ADDRESS + sizeof(alias_header_t) + (slot) * sizeof(alias_record_t))
+#define ALIAS_NAME_ADDRESS(slot) (ALIAS_RECORD_ADDRESS(slot) + offsetof(alias_record_t, name))
+
+_Static_assert(sizeof(alias_header_t) + ALIAS_COUNT * sizeof(alias_record_t) <= ALIAS_EEPROM_SIZE, "alias records do not fit their EEPROM region");
+
+// Records stay in EEPROM at a fixed slot, RAM only keeps the ids sorted with their slot
+// next to them, so a lookup is a binary search plus one read of the memory mapped name
+static struct
+{
+    uint64_t id[ALIAS_COUNT];
+    uint8_t slot[ALIAS_COUNT];
+    uint64_t used;
+    int count;
+    uint8_t cursor;
+    uint32_t generation;
+    bool formatted;
+
+} _alias;
+
+static int _alias_search(uint64_t id, bool *found);
+static bool _alias_name_valid(const char *name);
+static bool _alias_format(void);
+static uint32_t _alias_hash(uint64_t id, const char *name);
+
+void alias_init(void)
+{
+    alias_header_t header;
+
+    memset(&_alias, 0, sizeof(_alias));
+
+    storage_read(ALIAS_EEPROM_ADDRESS, &header, sizeof(header));
+
+    // Anything else in this area is formatted on the first change
+    if ((header.magic != ALIAS_MAGIC) || (header.version != ALIAS_VERSION))
+    {
+        return;
+    }
+
+    _alias.formatted = true;
+
+    for (int slot = 0; slot < ALIAS_COUNT; slot++)
+    {
+        alias_record_t record;
+        bool found;
+
+        storage_read(ALIAS_RECORD_ADDRESS(slot), &record, sizeof(record));
+
+        uint64_t id = record.id;
+
+        if (id == 0)
+        {
+            continue;
+        }
+
+        int index = _alias_search(id, &found);
+
+        if (found)
+        {
+            continue;
+        }
+
+        _alias.generation ^= _alias_hash(id, record.name);
+
+        memmove(&_alias.id[index + 1], &_alias.id[index], (_alias.count - index) * sizeof(_alias.id[0]));
+        memmove(&_alias.slot[index + 1], &_alias.slot[index], (_alias.count - index) * sizeof(_alias.slot[0]));
+
+        _alias.id[index] = id;
+        _alias.slot[index] = (uint8_t) slot;
+        _alias.used |= (uint64_t) 1 << slot;
+        _alias.count++;
+
+        _alias.cursor = (uint8_t) ((slot + 1) % ALIAS_COUNT);
+    }
+}
+
+bool alias_add(uint64_t *id, const char *name)
+{
+    bool found;
+    alias_record_t record;
+    uint64_t owner;
+
+    if ((*id == 0) || !_alias_name_valid(name))
+    {
+        return false;
+    }
+
+    // A name addresses exactly one node, renaming a node to its own name is fine
+    if (alias_find(name, strlen(name), &owner) && (owner != *id))
+    {
+        return false;
+    }
+
+    if (!_alias.formatted && !_alias_format())
+    {
+        return false;
+    }
+
+    int index = _alias_search(*id, &found);
+
+    // Valid names are at most ALIAS_NAME_LENGTH long, a full length name has no terminator in the record
+    memset(record.name, 0, sizeof(record.name));
+    memcpy(record.name, name, strlen(name));
+
+    if (found)
+    {
+        char stored[ALIAS_NAME_LENGTH];
+
+        storage_read(ALIAS_NAME_ADDRESS(_alias.slot[index]), stored, sizeof(stored));
+
+        if (!storage_write(ALIAS_NAME_ADDRESS(_alias.slot[index]), record.name, sizeof(record.name)))
+        {
+            return false;
+        }
+
+        _alias.generation ^= _alias_hash(*id, stored) ^ _alias_hash(*id, record.name);
+
+        return true;
+    }
+
+    if (_alias.count == ALIAS_COUNT)
+    {
+        return false;
+    }
+
+    // New records go round the slots instead of refilling the first free one,
+    // so adding and removing the same node does not wear a single record
+    int slot = _alias.cursor;
+
+    while (_alias.used & ((uint64_t) 1 << slot))
+    {
+        slot = (slot + 1) % ALIAS_COUNT;
+    }
+
+    _alias.cursor = (uint8_t) ((slot + 1) % ALIAS_COUNT);
+
+    record.id = *id;
+
+    if (!storage_write(ALIAS_RECORD_ADDRESS(slot), &record, sizeof(record)))
+    {
+        return false;
+    }
+
+    memmove(&_alias.id[index + 1], &_alias.id[index], (_alias.count - index) * sizeof(_alias.id[0]));
+    memmove(&_alias.slot[index + 1], &_alias.slot[index], (_alias.count - index) * sizeof(_alias.slot[0]));
+
+    _alias.id[index] = *id;
+    _alias.slot[index] = (uint8_t) slot;
+    _alias.used |= (uint64_t) 1 << slot;
+    _alias.count++;
+
+    _alias.generation ^= _alias_hash(*id, record.name);
+
+    return true;
+}
+
+bool alias_remove(uint64_t *id)
+{
+    bool found;
+    uint64_t empty = 0;
+
+    int index = _alias_search(*id, &found);
+
+    if (!found)
+    {
+        return false;
+    }
+
+    uint8_t slot = _alias.slot[index];
+    char stored[ALIAS_NAME_LENGTH];
+
+    storage_read(ALIAS_NAME_ADDRESS(slot), stored, sizeof(stored));
+
+    if (!storage_write(ALIAS_RECORD_ADDRESS(slot), &empty, sizeof(empty)))
+    {
+        return false;
+    }
+
+    _alias.generation ^= _alias_hash(*id, stored);
+
+    _alias.count--;
+
+    memmove(&_alias.id[index], &_alias.id[index + 1], (_alias.count - index) * sizeof(_alias.id[0]));
+    memmove(&_alias.slot[index], &_alias.slot[index + 1], (_alias.count - index) * sizeof(_alias.slot[0]));
+
+    _alias.used &= ~((uint64_t) 1 << slot);
+
+    return true;
+}
+
+bool alias_get(uint64_t *id, char *name, size_t size)
+{
+    bool found;
+
+    int index = _alias_search(*id, &found);
+
+    if (!found || (size == 0))
+    {
+        return false;
+    }
+
+    size_t length = size - 1 < ALIAS_NAME_LENGTH ? size - 1 : ALIAS_NAME_LENGTH;
+
+    storage_read(ALIAS_NAME_ADDRESS(_alias.slot[index]), name, length);
+
+    name[length] = 0;
+
+    return true;
+}
+
+bool alias_find(const char *name, size_t length, uint64_t *id)
+{
+    char stored[ALIAS_NAME_LENGTH];
+
+    if ((length == 0) || (length > ALIAS_NAME_LENGTH))
+    {
+        return false;
+    }
+
+    for (int i = 0; i < _alias.count; i++)
+    {
+        storage_read(ALIAS_NAME_ADDRESS(_alias.slot[i]), stored, sizeof(stored));
+
+        if ((strncmp(stored, name, length) == 0) && ((length == ALIAS_NAME_LENGTH) || (stored[length] == 0)))
+        {
+            *id = _alias.id[i];
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int alias_get_count(void)
+{
+    return _alias.count;
+}
+
+uint32_t alias_get_generation(void)
+{
+    return _alias.generation & ALIAS_GENERATION_MASK;
+}
+
+void alias_list(int page)
+{
+    char name[ALIAS_NAME_LENGTH + 1];
+    int offset = page * ALIAS_PAGE_SIZE;
+
+    usb_talk_message_start("$eeprom/alias/list/%d", page);
+
+    usb_talk_message_append("{");
+
+    for (int i = offset; (i >= 0) && (i < _alias.count) && (i < offset + ALIAS_PAGE_SIZE); i++)
+    {
+        storage_read(ALIAS_NAME_ADDRESS(_alias.slot[i]), name, ALIAS_NAME_LENGTH);
+
+        name[ALIAS_NAME_LENGTH] = 0;
+
+        usb_talk_message_append(i == offset ? "\"" USB_TALK_DEVICE_ADDRESS "\": \"%s\"" : ", \"" USB_TALK_DEVICE_ADDRESS "\": \"%s\"", _alias.id[i], name);
+    }
+
+    usb_talk_message_append("}");
+
+    usb_talk_message_send();
+}
+
+void alias_dump(uint32_t *generation)
+{
+    char name[ALIAS_NAME_LENGTH + 1];
+    uint32_t current = alias_get_generation();
+
+    usb_talk_message_start("$eeprom/alias/dump");
+
+    usb_talk_message_append("{\"generation\": %lu, \"count\": %d", (unsigned long) current, _alias.count);
+
+    if ((generation != NULL) && (*generation == current))
+    {
+        usb_talk_message_append(", \"unchanged\": true}");
+
+        usb_talk_message_send();
+
+        return;
+    }
+
+    usb_talk_message_append(", \"aliases\": {");
+
+    // A single frame, message_append hands full buffers to the transport and continues on the same line
+    for (int i = 0; i < _alias.count; i++)
+    {
+        storage_read(ALIAS_NAME_ADDRESS(_alias.slot[i]), name, ALIAS_NAME_LENGTH);
+
+        name[ALIAS_NAME_LENGTH] = 0;
+
+        usb_talk_message_append(i == 0 ? "\"" USB_TALK_DEVICE_ADDRESS "\": \"%s\"" : ", \"" USB_TALK_DEVICE_ADDRESS "\": \"%s\"", _alias.id[i], name);
+    }
+
+    usb_talk_message_append("}}");
+
+    usb_talk_message_send();
+}
+
+static int _alias_search(uint64_t id, bool *found)
+{
+    int low = 0;
+    int high = _alias.count;
+
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (_alias.id[middle] < id)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *found = (low < _alias.count) && (_alias.id[low] == id);
+
+    return low;
+}
+
+static bool _alias_name_valid(const char *name)
+{
+    size_t length = strlen(name);
+
+    if ((length == 0) || (length > ALIAS_NAME_LENGTH) || (name[0] == '$'))
+    {
+        return false;
+    }
+
+    // Would be taken for a node id or a group by the topic parser
+    if (((length == 12) && (strspn(name, "0123456789abcdefABCDEF") == 12)) || (strcmp(name, "group") == 0))
+    {
+        return false;
+    }
+
+    // Names may be used as a topic level and as a JSON string without escaping
+    for (size_t i = 0; i < length; i++)
+    {
+        char c = name[i];
+
+        if ((c <= ' ') || (c > '~') || (c == '/') || (c == '"') || (c == '\\') || (c == '+') || (c == '#'))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// FNV-1a of one record, the generation is the XOR of all of them. It follows every change,
+// needs no EEPROM write of its own and comes back to the same value when the same set is restored.
+static uint32_t _alias_hash(uint64_t id, const char *name)
+{
+    uint32_t hash = 2166136261u;
+
+    for (int i = 0; i < 8; i++)
+    {
+        hash = (hash ^ (uint8_t) (id >> (i * 8))) * 16777619u;
+    }
+
+    for (int i = 0; (i < ALIAS_NAME_LENGTH) && (name[i] != 0); i++)
+    {
+        hash = (hash ^ (uint8_t) name[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static bool _alias_format(void)
+{
+    alias_header_t header;
+    uint64_t empty = 0;
+
+    for (int slot = 0; slot < ALIAS_COUNT; slot++)
+    {
+        if (!storage_write(ALIAS_RECORD_ADDRESS(slot), &empty, sizeof(empty)))
+        {
+            return false;
+        }
+    }
+
+    memset(&header, 0, sizeof(header));
+
+    header.magic = ALIAS_MAGIC;
+    header.version = ALIAS_VERSION;
+
+    _alias.formatted = storage_write(ALIAS_EEPROM_ADDRESS, &header, sizeof(header));
+
+    return _alias.formatted;
+}
@@ -0,0 +1,33 @@
+#ifndef _ALIAS_H
+#define _ALIAS_H
+
+#include <bc_common.h>
+
+#define ALIAS_COUNT 64
+#define ALIAS_NAME_LENGTH 32
+#define ALIAS_PAGE_SIZE 8
+#define ALIAS_EEPROM_ADDRESS 0x0000
+#define ALIAS_EEPROM_SIZE 0x0a10
+#define ALIAS_GENERATION_MASK 0x7fffffff
+
+void alias_init(void);
+bool alias_add(uint64_t *id, const char *name);
+bool alias_remove(uint64_t *id);
+
+// Binary search in the RAM index, the name is read from the memory mapped EEPROM
+bool alias_get(uint64_t *id, char *name, size_t size);
+
+// Linear, meant for the rare command addressed by alias
+bool alias_find(const char *name, size_t length, uint64_t *id);
+
+int alias_get_count(void);
+
+// Changes with every add, rename and remove, fits a JSON integer
+uint32_t alias_get_generation(void);
+
+void alias_list(int page);
+
+// Whole table in one frame, only the header when generation is the one the host already has
+void alias_dump(uint32_t *generation);
+
+#endif
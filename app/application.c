@@ -1,9 +1,26 @@
 #include <application.h>
 #include <radio.h>
 #include <usb_talk.h>
-#include <eeprom.h>
+#include <storage.h>
+#include <alias.h>
+#include <node_table.h>
+#include <node_stats.h>
+#include <outbox.h>
+#include <group.h>
+#include <lcd_remote.h>
+#include <compound.h>
+#include <stream.h>
+#include <history.h>
+#include <activity.h>
+#include <profile.h>
+#include <ram.h>
+#include <stats.h>
+#include <trace.h>
+#include <timestamp.h>
 #if CORE_MODULE
 #include <sensors.h>
+#include <config.h>
+#include <dashboard.h>
 #endif
 
 #include "vv_radio.h"
@@ -11,6 +28,11 @@
 
 #define APPLICATION_TASK_ID 0
 
+#define LCD_UPDATE_INTERVAL 500
+#define LCD_UPDATE_RETRY 20
+
+#define LED_STRIP_COMPOUND_MAX_TUPLES 64
+
 static uint64_t my_id;
 static bc_led_t led;
 static bool led_state;
@@ -21,8 +43,12 @@ static struct
 {
     bc_tick_t next_update;
     bool mqtt;
+    bool dirty;
 } lcd;
 
+static void lcd_invalidate(void);
+static void lcd_stream_update_handler(int index, void *param);
+
 static bc_module_relay_t relay_0_0;
 static bc_module_relay_t relay_0_1;
 
@@ -31,6 +57,7 @@ static void lcd_button_event_handler(bc_button_t *self, bc_button_event_t event,
 #endif
 
 static void radio_event_handler(bc_radio_event_t event, void *event_param);
+static int radio_packet_received(uint64_t *id, node_stats_packet_t type);
 static void led_state_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void led_state_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void relay_state_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
@@ -48,6 +75,23 @@ static void led_strip_thermometer_set(uint64_t *id, usb_talk_payload_t *payload,
 
 static void info_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void nodes_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void nodes_stats(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void outbox_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void stream_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void stream_config_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void stream_stats_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void history_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void profile_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void profile_reset_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void memory_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void stats_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void stats_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void trace_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void trace_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void trace_reset_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void time_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void time_sync(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void time_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void nodes_purge(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void nodes_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void nodes_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
@@ -58,11 +102,25 @@ static void pairing_stop(uint64_t *id, usb_talk_payload_t *payload, usb_talk_sub
 static void automatic_pairing_start(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 static void automatic_pairing_stop(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 
-static void alias_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
-static void alias_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
-static void alias_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void alias_name_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void alias_name_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void alias_name_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void alias_name_dump(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void alias_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void storage_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+
+static void group_member_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void group_member_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void group_member_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 
 static void update_vv_display(uint64_t *device_address, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+#if CORE_MODULE
+static void sensors_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void sensors_bus_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void config_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+static void config_reset(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
+#endif
 
 const usb_talk_subscribe_t subscribes[] = {
     {"led/-/state/set", led_state_set, 0, NULL},
@@ -84,18 +142,60 @@ const usb_talk_subscribe_t subscribes[] = {
     {"led-strip/-/thermometer/set", led_strip_thermometer_set, 0, NULL},
     {"/info/get", info_get, 0, NULL},
     {"/nodes/get", nodes_get, 0, NULL},
+    {"/nodes/stats", nodes_stats, 0, NULL},
     {"/nodes/add", nodes_add, 0, NULL},
     {"/nodes/remove", nodes_remove, 0, NULL},
     {"/nodes/purge", nodes_purge, 0, NULL},
+    {"/outbox/get", outbox_get, 0, NULL},
+    {"/stream/config/set", stream_config_set, 0, NULL},
+    {"/stream/config/get", stream_config_get, 0, NULL},
+    {"/stream/stats/get", stream_stats_get, 0, NULL},
+    {"/history/get", history_get, 0, NULL},
+    {"/profile/get", profile_get, 0, NULL},
+    {"/profile/reset", profile_reset_set, 0, NULL},
+    {"/memory/get", memory_get, 0, NULL},
+    {"/stats/get", stats_get, 0, NULL},
+    {"/stats/config/set", stats_config_set, 0, NULL},
+    {"/trace/get", trace_get, 0, NULL},
+    {"/trace/config/set", trace_config_set, 0, NULL},
+    {"/trace/reset", trace_reset_set, 0, NULL},
+    {"/time/get", time_get, 0, NULL},
+    {"/time/sync", time_sync, 0, NULL},
+    {"/time/config/set", time_config_set, 0, NULL},
     {"/scan/start", scan_start, 0, NULL},
     {"/scan/stop", scan_stop, 0, NULL},
     {"/pairing-mode/start", pairing_start, 0, NULL},
     {"/pairing-mode/stop", pairing_stop, 0, NULL},
     {"/automatic-pairing/start", automatic_pairing_start, 0, NULL},
     {"/automatic-pairing/stop", automatic_pairing_stop, 0, NULL},
-    {"$eeprom/alias/add", alias_add, 0, NULL},
-    {"$eeprom/alias/remove", alias_remove, 0, NULL},
-    {"$eeprom/alias/list", alias_list, 0, NULL},
+    {"$eeprom/alias/add", alias_name_add, 0, NULL},
+    {"$eeprom/alias/remove", alias_name_remove, 0, NULL},
+    {"$eeprom/alias/list", alias_name_list, 0, NULL},
+    {"$eeprom/alias/dump", alias_name_dump, 0, NULL},
+    {"/alias/config/set", alias_config_set, 0, NULL},
+    {"/storage/get", storage_get, 0, NULL},
+    {"$eeprom/group/add", group_member_add, 0, NULL},
+    {"$eeprom/group/remove", group_member_remove, 0, NULL},
+    {"$eeprom/group/list", group_member_list, 0, NULL},
+#if CORE_MODULE
+    {"/sensors/get", sensors_get, 0, NULL},
+    {"/sensors/bus/get", sensors_bus_get, 0, NULL},
+    {"$config/thermometer/set", config_set, SENSOR_TYPE_TEMPERATURE, NULL},
+    {"$config/thermometer/get", config_get, SENSOR_TYPE_TEMPERATURE, NULL},
+    {"$config/thermometer/reset", config_reset, SENSOR_TYPE_TEMPERATURE, NULL},
+    {"$config/hygrometer/set", config_set, SENSOR_TYPE_HUMIDITY, NULL},
+    {"$config/hygrometer/get", config_get, SENSOR_TYPE_HUMIDITY, NULL},
+    {"$config/hygrometer/reset", config_reset, SENSOR_TYPE_HUMIDITY, NULL},
+    {"$config/lux-meter/set", config_set, SENSOR_TYPE_LUX_METER, NULL},
+    {"$config/lux-meter/get", config_get, SENSOR_TYPE_LUX_METER, NULL},
+    {"$config/lux-meter/reset", config_reset, SENSOR_TYPE_LUX_METER, NULL},
+    {"$config/barometer/set", config_set, SENSOR_TYPE_BAROMETER, NULL},
+    {"$config/barometer/get", config_get, SENSOR_TYPE_BAROMETER, NULL},
+    {"$config/barometer/reset", config_reset, SENSOR_TYPE_BAROMETER, NULL},
+    {"$config/co2-meter/set", config_set, SENSOR_TYPE_CO2, NULL},
+    {"$config/co2-meter/get", config_get, SENSOR_TYPE_CO2, NULL},
+    {"$config/co2-meter/reset", config_reset, SENSOR_TYPE_CO2, NULL},
+#endif
 
     {"vv-display/-/power/set", update_vv_display, VV_RADIO_DATA_TYPE_L1_POWER, NULL},
     {"vv-display/-/fve/set", update_vv_display, VV_RADIO_DATA_TYPE_FVE_POWER, NULL},
@@ -108,10 +208,27 @@ const usb_talk_subscribe_t subscribes[] = {
 
 void application_init(void)
 {
+    ram_init();
+
+    profile_init();
+
     bc_led_init(&led, GPIO_LED, false, false);
     bc_led_set_mode(&led, BC_LED_MODE_OFF);
 
-    eeprom_init();
+    activity_init(&led);
+
+    storage_init();
+    alias_init();
+
+    node_table_init();
+    node_stats_init();
+    outbox_init();
+    lcd_remote_init();
+    stream_init();
+    history_init();
+    stats_init();
+    timestamp_init();
+    trace_init();
 
     usb_talk_init();
     usb_talk_subscribes(subscribes, sizeof(subscribes) / sizeof(usb_talk_subscribe_t));
@@ -128,6 +245,13 @@ void application_init(void)
     bc_module_lcd_clear();
     bc_module_lcd_update();
 
+    // Until the host draws its own content the LCD shows the latest received values
+    dashboard_init();
+    dashboard_draw();
+    lcd_invalidate();
+
+    stream_set_update_handler(lcd_stream_update_handler, NULL);
+
     static bc_button_t button;
     bc_button_init(&button, BC_GPIO_BUTTON, BC_GPIO_PULL_DOWN, false);
     bc_button_set_event_handler(&button, button_event_handler, NULL);
@@ -140,6 +264,8 @@ void application_init(void)
     bc_button_init_virtual(&lcd_right, BC_MODULE_LCD_BUTTON_RIGHT, bc_module_lcd_get_button_driver(), false);
     bc_button_set_event_handler(&lcd_right, lcd_button_event_handler, NULL);
 
+    config_init();
+
     sensors_init_all(&my_id);
 
     bc_module_relay_init(&relay_0_0, BC_MODULE_RELAY_I2C_ADDRESS_DEFAULT);
@@ -159,10 +285,20 @@ static void radio_event_handler(bc_radio_event_t event, void *event_param)
 
     uint64_t id = bc_radio_get_event_id();
 
+    trace_cancel();
+    timestamp_capture_cancel();
+
     if (event == BC_RADIO_EVENT_ATTACH)
     {
         bc_led_pulse(&led, 1000);
 
+        int slot = node_table_add(id);
+
+        node_stats_clear(slot);
+        node_stats_seen(slot);
+
+        lcd_remote_forget(&id);
+
         usb_talk_send_format("[\"/attach\", \"" USB_TALK_DEVICE_ADDRESS "\"]\n", id);
     }
     else if (event == BC_RADIO_EVENT_ATTACH_FAILURE)
@@ -175,11 +311,19 @@ static void radio_event_handler(bc_radio_event_t event, void *event_param)
     {
         bc_led_pulse(&led, 1000);
 
+        outbox_forget(&id);
+
+        node_table_remove(id);
+
+        stream_forget(&id);
+
         usb_talk_send_format("[\"/detach\", \"" USB_TALK_DEVICE_ADDRESS "\"]\n", id);
     }
     else if (event == BC_RADIO_EVENT_INIT_DONE)
     {
         my_id = bc_radio_get_my_id();
+
+        node_table_reload();
     }
     else if (event == BC_RADIO_EVENT_SCAN_FIND_DEVICE)
     {
@@ -187,9 +331,27 @@ static void radio_event_handler(bc_radio_event_t event, void *event_param)
     }
 }
 
+static int radio_packet_received(uint64_t *id, node_stats_packet_t type)
+{
+    trace_begin();
+    timestamp_capture(bc_tick_get());
+
+    int slot = node_table_find(*id);
+
+    node_stats_packet(slot, type);
+
+    outbox_node_seen(id);
+
+    return slot;
+}
+
 void bc_radio_pub_on_event_count(uint64_t *id, uint8_t event_id, uint16_t *event_count)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    int slot = radio_packet_received(id, NODE_STATS_PACKET_EVENT_COUNT);
+
+    node_stats_event_count(slot, event_id, *event_count);
 
     if (event_id == BC_RADIO_PUB_EVENT_PUSH_BUTTON)
     {
@@ -215,49 +377,92 @@ void bc_radio_pub_on_event_count(uint64_t *id, uint8_t event_id, uint16_t *event
 
 void bc_radio_pub_on_temperature(uint64_t *id, uint8_t channel, float *celsius)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_TEMPERATURE);
 
-    usb_talk_publish_temperature(id, channel, celsius);
+    value_t value = VALUE_TEMPERATURE(*celsius);
+
+    if (stream_update(id, STREAM_KIND_TEMPERATURE, channel, &value))
+    {
+        usb_talk_publish_temperature(id, channel, &value);
+    }
 }
 
 void bc_radio_pub_on_humidity(uint64_t *id, uint8_t channel, float *percentage)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
 
-    usb_talk_publish_humidity(id, channel, percentage);
+    radio_packet_received(id, NODE_STATS_PACKET_HUMIDITY);
+
+    value_t value = VALUE_HUMIDITY(*percentage);
+
+    if (stream_update(id, STREAM_KIND_HUMIDITY, channel, &value))
+    {
+        usb_talk_publish_humidity(id, channel, &value);
+    }
 }
 
 void bc_radio_pub_on_lux_meter(uint64_t *id, uint8_t channel, float *illuminance)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
 
-    usb_talk_publish_lux_meter(id, channel, illuminance);
+    radio_packet_received(id, NODE_STATS_PACKET_LUX_METER);
+
+    value_t value = VALUE_ILLUMINANCE(*illuminance);
+
+    if (stream_update(id, STREAM_KIND_LUX_METER, channel, &value))
+    {
+        usb_talk_publish_lux_meter(id, channel, &value);
+    }
 }
 
 void bc_radio_pub_on_barometer(uint64_t *id, uint8_t channel, float *pressure, float *altitude)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_BAROMETER);
 
-    usb_talk_publish_barometer(id, channel, pressure, altitude);
+    value_t pascal = VALUE_PRESSURE(*pressure);
+    value_t meter = VALUE_ALTITUDE(*altitude);
+
+    if (stream_update(id, STREAM_KIND_PRESSURE, channel, &pascal))
+    {
+        usb_talk_publish_barometer(id, channel, &pascal, &meter);
+    }
 }
 
 void bc_radio_pub_on_co2(uint64_t *id, float *concentration)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_CO2);
+
+    value_t value = VALUE_CONCENTRATION(*concentration);
 
-    usb_talk_publish_co2(id, concentration);
+    if (stream_update(id, STREAM_KIND_CO2, 0, &value))
+    {
+        usb_talk_publish_co2(id, &value);
+    }
 }
 
 void bc_radio_pub_on_battery(uint64_t *id, float *voltage)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_BATTERY);
+
+    value_t value = VALUE_VOLTAGE(*voltage);
 
-    usb_talk_send_format("[\"%012llx/battery/-/voltage\", %.2f]\n", *id, *voltage);
+    if (stream_update(id, STREAM_KIND_VOLTAGE, 0, &value))
+    {
+        usb_talk_publish_battery(id, &value);
+    }
 }
 
 void bc_radio_pub_on_state(uint64_t *id, uint8_t who, bool *state)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
 
     static const char *lut[] = {
             [BC_RADIO_PUB_STATE_LED] = "led/-/state",
@@ -266,6 +471,21 @@ void bc_radio_pub_on_state(uint64_t *id, uint8_t who, bool *state)
             [BC_RADIO_PUB_STATE_POWER_MODULE_RELAY] = "relay/-/state"
     };
 
+    static const uint8_t state_id[] = {
+            [BC_RADIO_PUB_STATE_LED] = BC_RADIO_NODE_STATE_LED,
+            [BC_RADIO_PUB_STATE_RELAY_MODULE_0] = BC_RADIO_NODE_STATE_RELAY_MODULE_0,
+            [BC_RADIO_PUB_STATE_RELAY_MODULE_1] = BC_RADIO_NODE_STATE_RELAY_MODULE_1,
+            [BC_RADIO_PUB_STATE_POWER_MODULE_RELAY] = BC_RADIO_NODE_STATE_POWER_MODULE_RELAY
+    };
+
+    // Acknowledge before the outbox releases commands for this node
+    if (who < 4)
+    {
+        outbox_state_ack(id, state_id[who], state);
+    }
+
+    radio_packet_received(id, NODE_STATS_PACKET_STATE);
+
     if (who < 4)
     {
         usb_talk_publish_bool(id, lut[who], state);
@@ -274,28 +494,41 @@ void bc_radio_pub_on_state(uint64_t *id, uint8_t who, bool *state)
 
 void bc_radio_on_info(uint64_t *id, char *firmware, char *version)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_INFO);
 
-    usb_talk_send_format("[\"" USB_TALK_DEVICE_ADDRESS "/info\", {\"firmware\": \"%s\", \"version\": \"%s\"} ]\n", *id, firmware, version);
+    // Node has just started, its display is empty
+    lcd_remote_forget(id);
+
+    usb_talk_message_start_id(id, "info");
+    usb_talk_message_append("{\"firmware\": \"%s\", \"version\": \"%s\"}", firmware, version);
+    usb_talk_message_send();
 }
 
 void bc_radio_pub_on_bool(uint64_t *id, char *subtopic, bool *value)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_VALUE);
 
     usb_talk_publish_bool(id, subtopic, value);
 }
 
 void bc_radio_pub_on_int(uint64_t *id, char *subtopic, int *value)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_VALUE);
 
     usb_talk_publish_int(id, subtopic, value);
 }
 
 void bc_radio_pub_on_float(uint64_t *id, char *subtopic, float *value)
 {
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_VALUE);
 
     usb_talk_publish_float(id, subtopic, value);
 }
@@ -307,7 +540,9 @@ void bc_radio_pub_on_buffer(uint64_t *id, uint8_t *buffer, size_t length)
         return;
     }
 
-    bc_led_pulse(&led, 10);
+    activity_signal(ACTIVITY_RX);
+
+    radio_packet_received(id, NODE_STATS_PACKET_BUFFER);
 
     if(buffer[0] == VV_RADIO_SINGLE_FLOAT) {
 	struct vv_radio_single_float_packet packet;
@@ -355,11 +590,13 @@ static void led_state_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_su
 
         bc_led_set_mode(&led, led_state ? BC_LED_MODE_ON : BC_LED_MODE_OFF);
 
+        activity_set_enabled(!led_state);
+
         usb_talk_publish_led(&my_id, &led_state);
     }
     else
     {
-        bc_radio_node_state_set(id, BC_RADIO_NODE_STATE_LED, &state);
+        outbox_state_set(id, BC_RADIO_NODE_STATE_LED, &state);
     }
 }
 
@@ -396,7 +633,7 @@ static void relay_state_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_
     }
     else
     {
-        bc_radio_node_state_set(id, BC_RADIO_NODE_STATE_POWER_MODULE_RELAY, &state);
+        outbox_state_set(id, BC_RADIO_NODE_STATE_POWER_MODULE_RELAY, &state);
     }
 }
 
@@ -429,7 +666,7 @@ static void module_relay_state_set(uint64_t *id, usb_talk_payload_t *payload, us
 
     if (my_id != *id)
     {
-        bc_radio_node_state_set(id, sub->number == 0 ? BC_RADIO_NODE_STATE_RELAY_MODULE_0 : BC_RADIO_NODE_STATE_RELAY_MODULE_1, &state);
+        outbox_state_set(id, sub->number == 0 ? BC_RADIO_NODE_STATE_RELAY_MODULE_0 : BC_RADIO_NODE_STATE_RELAY_MODULE_1, &state);
     }
 #if CORE_MODULE
     else
@@ -577,21 +814,13 @@ static void lcd_text_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_sub
         }
 
         bc_module_lcd_draw_string(x, y, text, color);
+
+        lcd_invalidate();
 #endif
     }
     else
     {
-        uint8_t buffer[1 + sizeof(uint64_t) + 5 + 32]; // HEAD + ADDRESS + X + Y + FONT_SIZE + LENGTH + TEXT
-        buffer[0] = RADIO_LCD_TEXT_SET;
-        memcpy(buffer + 1, id, sizeof(uint64_t));
-        buffer[sizeof(uint64_t) + 1] = (uint8_t) x;
-        buffer[sizeof(uint64_t) + 2] = (uint8_t) y;
-        buffer[sizeof(uint64_t) + 3] = (uint8_t) font_size;
-        buffer[sizeof(uint64_t) + 4] = (uint8_t) color;
-        buffer[sizeof(uint64_t) + 5] = (uint8_t) length;
-        memcpy(buffer + sizeof(uint64_t) + 6, text, length + 1);
-
-        bc_radio_pub_buffer(buffer, 1 + sizeof(uint64_t) + 4 + length + 1);
+        lcd_remote_text_set(id, x, y, font_size, color, text, length);
     }
 }
 
@@ -602,15 +831,14 @@ static void lcd_screen_clear(uint64_t *id, usb_talk_payload_t *payload, usb_talk
 
     if (my_id != *id)
     {
-        uint8_t buffer[1 + sizeof(uint64_t)];
-        buffer[0] = RADIO_LCD_SCREEN_CLEAR;
-        memcpy(buffer + 1, id, sizeof(uint64_t));
-        bc_radio_pub_buffer(buffer, sizeof(buffer));
+        lcd_remote_screen_clear(id);
     }
 #if CORE_MODULE
     else
     {
         bc_module_lcd_clear();
+
+        lcd_invalidate();
     }
 #endif
 }
@@ -654,15 +882,37 @@ static void led_strip_compound_set(uint64_t *id, usb_talk_payload_t *payload, us
 {
     (void) sub;
 
-    uint8_t compound[BC_RADIO_NODE_MAX_COMPOUND_BUFFER_SIZE];
+    static uint8_t compound[COMPOUND_TUPLE_SIZE * LED_STRIP_COMPOUND_MAX_TUPLES];
 
     size_t length = sizeof(compound);
 
     int count_sum;
 
-    usb_talk_payload_get_compound(payload, compound, &length, &count_sum);
+    if (!usb_talk_payload_get_compound(payload, compound, &length, &count_sum))
+    {
+        return;
+    }
+
+    if (length <= BC_RADIO_NODE_MAX_COMPOUND_BUFFER_SIZE)
+    {
+        bc_radio_node_led_strip_compound_set(id, compound, length);
+
+        return;
+    }
+
+    // Too long for the plain compound packet, try palette and run length packing
+    uint8_t buffer[1 + sizeof(uint64_t) + BC_RADIO_NODE_MAX_COMPOUND_BUFFER_SIZE]; // HEAD + ADDRESS + PACKED COMPOUND
+    size_t packed_length = BC_RADIO_NODE_MAX_COMPOUND_BUFFER_SIZE;
 
-    bc_radio_node_led_strip_compound_set(id, compound, length);
+    if (!compound_encode(compound, length, buffer + 1 + sizeof(uint64_t), &packed_length))
+    {
+        return;
+    }
+
+    buffer[0] = RADIO_LED_STRIP_COMPOUND_PACKED_SET;
+    memcpy(buffer + 1, id, sizeof(uint64_t));
+
+    bc_radio_pub_buffer(buffer, 1 + sizeof(uint64_t) + packed_length);
 }
 
 static void led_strip_effect_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
@@ -764,49 +1014,292 @@ static void nodes_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscr
 {
     (void) id;
     (void) sub;
+
+    int page = -1;
+
+    usb_talk_payload_get_int(payload, &page);
+
+    const uint64_t *ids = node_table_get_ids();
+    int count = node_table_get_count();
+
+    if (page < 0)
+    {
+        usb_talk_publish_nodes(ids, count);
+
+        return;
+    }
+
+    int pages = (count + NODE_TABLE_PAGE_SIZE - 1) / NODE_TABLE_PAGE_SIZE;
+    int offset = page * NODE_TABLE_PAGE_SIZE;
+    int length = 0;
+
+    if (offset < count)
+    {
+        length = (count - offset) < NODE_TABLE_PAGE_SIZE ? (count - offset) : NODE_TABLE_PAGE_SIZE;
+    }
+    else
+    {
+        offset = 0;
+    }
+
+    usb_talk_publish_nodes_page(ids + offset, length, page, pages);
+}
+
+
+static void nodes_stats(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    node_stats_publish();
+}
+
+static void outbox_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    outbox_publish();
+}
+
+static void stream_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    int period;
+    bool raw;
+
+    if (usb_talk_payload_get_key_int(payload, "period", &period) && (period > 0))
+    {
+        stream_set_period((bc_tick_t) period * 1000);
+    }
+
+    if (usb_talk_payload_get_key_bool(payload, "raw", &raw))
+    {
+        stream_set_raw(raw);
+    }
+
+    stream_publish_config();
+}
+
+static void stream_config_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
     (void) payload;
+    (void) sub;
 
-    uint64_t peer_devices_address[BC_RADIO_MAX_DEVICES];
+    stream_publish_config();
+}
 
-    bc_radio_get_peer_id(peer_devices_address, BC_RADIO_MAX_DEVICES);
+static void stream_stats_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    stream_publish_stats();
+}
+
+static void history_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    // Seconds of gateway uptime, milliseconds in an int would overflow after 24 days
+    int from = 0;
+    int to = -1;
+
+    usb_talk_payload_get_key_int(payload, "from", &from);
+    usb_talk_payload_get_key_int(payload, "to", &to);
+
+    history_publish(from < 0 ? 0 : (bc_tick_t) from * 1000, to < 0 ? BC_TICK_INFINITY : (bc_tick_t) to * 1000 + 999);
+}
+
+static void profile_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
 
-    usb_talk_publish_nodes(peer_devices_address, BC_RADIO_MAX_DEVICES);
+    profile_publish();
 }
 
+static void profile_reset_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    profile_reset();
+
+    profile_publish();
+}
 
-void _radio_node(usb_talk_payload_t *payload, bool (*call)(uint64_t))
+static void memory_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    ram_publish();
+}
+
+static void stats_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    stats_publish();
+}
+
+static void stats_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    int interval;
+
+    if (usb_talk_payload_get_key_int(payload, "interval", &interval) && (interval >= 0))
+    {
+        stats_set_interval((bc_tick_t) interval * 1000);
+    }
+
+    stats_publish_config();
+}
+
+static void trace_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    trace_publish();
+}
+
+static void trace_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    bool append;
+
+    if (usb_talk_payload_get_key_bool(payload, "append", &append))
+    {
+        trace_set_append(append);
+    }
+
+    trace_publish();
+}
+
+static void trace_reset_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    trace_reset();
+
+    trace_publish();
+}
+
+static void time_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    timestamp_publish();
+}
+
+static void time_sync(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    int time;
+
+    // Seconds since the epoch, the reply pairs it with the tick it was applied at
+    if (!usb_talk_payload_get_key_int(payload, "time", &time) || (time < 0))
+    {
+        return;
+    }
+
+    timestamp_sync((uint32_t) time);
+
+    timestamp_publish();
+}
+
+static void time_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    bool stamp;
+
+    if (usb_talk_payload_get_key_bool(payload, "stamp", &stamp))
+    {
+        timestamp_set_enabled(stamp);
+    }
+
+    timestamp_publish();
+}
+
+static bool _radio_node(usb_talk_payload_t *payload, bool (*call)(uint64_t), uint64_t *id)
 {
     char tmp[13];
     size_t length = sizeof(tmp);
 
     if (!usb_talk_payload_get_string(payload, tmp, &length))
     {
-        return;
+        return false;
     }
 
     if (length == 12)
     {
-        uint64_t id = 0;
-
-        if (sscanf(tmp, "%012llx/", &id))
+        if (sscanf(tmp, USB_TALK_DEVICE_ADDRESS_SCAN "/", id))
         {
-            call(id);
+            // The SDK writes the peer table right away, what is queued lands before it
+            storage_flush();
+
+            return call(*id);
         }
     }
+
+    return false;
 }
 
 static void nodes_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
 {
     (void) id;
     (void) sub;
-    _radio_node(payload, bc_radio_peer_device_add);
+
+    uint64_t node_id = 0;
+
+    if (_radio_node(payload, bc_radio_peer_device_add, &node_id))
+    {
+        node_stats_clear(node_table_add(node_id));
+
+        lcd_remote_forget(&node_id);
+    }
 }
 
 static void nodes_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
 {
     (void) id;
     (void) sub;
-    _radio_node(payload, bc_radio_peer_device_remove);
+
+    uint64_t node_id = 0;
+
+    if (_radio_node(payload, bc_radio_peer_device_remove, &node_id))
+    {
+        outbox_forget(&node_id);
+
+        node_table_remove(node_id);
+    }
 }
 
 static void nodes_purge(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
@@ -814,8 +1307,14 @@ static void nodes_purge(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subs
     (void) id;
     (void) payload;
 
+    storage_flush();
+
     bc_radio_peer_device_purge_all();
 
+    node_table_purge();
+
+    outbox_init();
+
     nodes_get(id, payload, sub);
 }
 
@@ -852,6 +1351,11 @@ static void pairing_start(uint64_t *id, usb_talk_payload_t *payload, usb_talk_su
 
     bc_led_set_mode(&led, BC_LED_MODE_BLINK_FAST);
 
+    activity_set_enabled(false);
+
+    // Peers paired from now on are written by the SDK without passing the queue
+    storage_flush();
+
     bc_radio_pairing_mode_start();
 
     usb_talk_send_string("[\"/pairing-mode\", \"start\"]\n");
@@ -867,6 +1371,8 @@ static void pairing_stop(uint64_t *id, usb_talk_payload_t *payload, usb_talk_sub
 
     bc_led_set_mode(&led, BC_LED_MODE_OFF);
 
+    activity_set_enabled(true);
+
     bc_radio_pairing_mode_stop();
 
     usb_talk_send_string("[\"/pairing-mode\", \"stop\"]\n");
@@ -880,6 +1386,10 @@ static void automatic_pairing_start(uint64_t *id, usb_talk_payload_t *payload, u
 
     bc_led_set_mode(&led, BC_LED_MODE_BLINK_FAST);
 
+    activity_set_enabled(false);
+
+    storage_flush();
+
     bc_radio_automatic_pairing_start();
 
     usb_talk_send_string("[\"/automatic-pairing\", \"stop\"]\n");
@@ -893,12 +1403,14 @@ static void automatic_pairing_stop(uint64_t *id, usb_talk_payload_t *payload, us
 
     bc_led_set_mode(&led, BC_LED_MODE_OFF);
 
+    activity_set_enabled(true);
+
     bc_radio_automatic_pairing_stop();
 
     usb_talk_send_string("[\"/automatic-pairing\", \"stop\"]\n");
 }
 
-static void alias_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+static void alias_name_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
 {
     (void) id;
     (void) sub;
@@ -910,7 +1422,7 @@ static void alias_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscr
         return;
     }
 
-    char name[EEPROM_ALIAS_NAME_LENGTH + 1];
+    char name[ALIAS_NAME_LENGTH + 1];
     size_t length = sizeof(name);
 
     if (!usb_talk_payload_get_key_string(payload, "name", name, &length))
@@ -918,10 +1430,10 @@ static void alias_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscr
         return;
     }
 
-    eeprom_alias_add(&node_id, name);
+    alias_add(&node_id, name);
 }
 
-static void alias_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+static void alias_name_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
 {
     (void) id;
     (void) sub;
@@ -933,10 +1445,10 @@ static void alias_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_sub
         return;
     }
 
-    eeprom_alias_remove(&node_id);
+    alias_remove(&node_id);
 }
 
-static void alias_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+static void alias_name_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
 {
     (void) id;
     (void) sub;
@@ -948,20 +1460,154 @@ static void alias_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subsc
         return;
     }
 
-    eeprom_alias_list(page);
+    alias_list(page);
+}
+
+static void alias_name_dump(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    int generation;
+
+    if (usb_talk_payload_get_key_int(payload, "generation", &generation) && (generation >= 0))
+    {
+        uint32_t known = (uint32_t) generation;
+
+        alias_dump(&known);
+
+        return;
+    }
+
+    alias_dump(NULL);
+}
+
+static void alias_config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    bool topics;
+
+    if (usb_talk_payload_get_key_bool(payload, "topics", &topics))
+    {
+        usb_talk_set_alias_topics(topics);
+    }
+
+    usb_talk_send_format("[\"/alias/config\", {\"topics\": %s, \"count\": %d, \"capacity\": %d}]\n",
+            usb_talk_get_alias_topics() ? "true" : "false", alias_get_count(), ALIAS_COUNT);
+}
+
+static void storage_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    storage_publish();
+}
+
+static void group_member_add(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    uint64_t node_id;
+    char name[GROUP_NAME_LENGTH + 1];
+    size_t length = sizeof(name);
+
+    if (!usb_talk_payload_get_key_string(payload, "name", name, &length))
+    {
+        return;
+    }
+
+    if (!usb_talk_payload_get_key_node_id(payload, "id", &node_id))
+    {
+        return;
+    }
+
+    group_add(name, &node_id);
+
+    group_list();
+}
+
+static void group_member_remove(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) sub;
+
+    uint64_t node_id;
+    char name[GROUP_NAME_LENGTH + 1];
+    size_t length = sizeof(name);
+
+    if (!usb_talk_payload_get_key_string(payload, "name", name, &length))
+    {
+        return;
+    }
+
+    // Without a node id the whole group is deleted
+    if (usb_talk_payload_get_key_node_id(payload, "id", &node_id))
+    {
+        group_remove(name, &node_id);
+    }
+    else
+    {
+        group_remove(name, NULL);
+    }
+
+    group_list();
+}
+
+static void group_member_list(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    group_list();
 }
 
 #if CORE_MODULE
 void application_task(void)
 {
-    bc_tick_t now = bc_tick_get();
-    if (lcd.next_update < now)
+    // Runs only when something was drawn, otherwise stays unplanned
+    if (!lcd.dirty)
+    {
+        return;
+    }
+
+    if (!bc_module_lcd_update())
+    {
+        bc_scheduler_plan_current_relative(LCD_UPDATE_RETRY);
+
+        return;
+    }
+
+    lcd.dirty = false;
+    lcd.next_update = bc_tick_get() + LCD_UPDATE_INTERVAL;
+}
+
+static void lcd_invalidate(void)
+{
+    if (lcd.dirty)
     {
-        bc_module_lcd_update();
-        lcd.next_update = now + 500;
+        return;
     }
 
-    bc_scheduler_plan_current_relative(500);
+    lcd.dirty = true;
+
+    // Draws coming in quick succession end up in one framebuffer transfer
+    bc_scheduler_plan_absolute(APPLICATION_TASK_ID, lcd.next_update);
+}
+
+static void lcd_stream_update_handler(int index, void *param)
+{
+    (void) param;
+
+    if (!lcd.mqtt && dashboard_update(index))
+    {
+        lcd_invalidate();
+    }
 }
 
 static void button_event_handler(bc_button_t *self, bc_button_event_t event, void *event_param)
@@ -985,27 +1631,171 @@ static void button_event_handler(bc_button_t *self, bc_button_event_t event, voi
             radio_pairing_mode = false;
             bc_radio_pairing_mode_stop();
             bc_led_set_mode(&led, BC_LED_MODE_OFF);
+            activity_set_enabled(true);
             usb_talk_send_string("[\"/pairing-mode\", \"stop\"]\n");
         }
         else{
             radio_pairing_mode = true;
             bc_radio_pairing_mode_start();
             bc_led_set_mode(&led, BC_LED_MODE_BLINK_FAST);
+            activity_set_enabled(false);
             usb_talk_send_string("[\"/pairing-mode\", \"start\"]\n");
         }
     }
 }
 
+static void sensors_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    sensors_publish_inventory();
+}
+
+static void sensors_bus_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+    (void) payload;
+    (void) sub;
+
+    sensors_publish_bus();
+}
+
+static bool config_channel_get(usb_talk_payload_t *payload, int *channel)
+{
+    char tmp[5];
+    size_t length = sizeof(tmp);
+    int bus;
+    int number;
+
+    memset(tmp, 0, sizeof(tmp));
+
+    *channel = CONFIG_CHANNEL_CLASS;
+
+    if (!usb_talk_payload_get_key_string(payload, "channel", tmp, &length))
+    {
+        return true;
+    }
+
+    // Same notation as the topics, bus:channel
+    if ((sscanf(tmp, "%d:%d", &bus, &number) != 2) || (bus < 0) || (bus > 1) || (number < 0) || (number > 0x7f))
+    {
+        return false;
+    }
+
+    *channel = (bus << 7) | number;
+
+    return true;
+}
+
+static void config_set(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+
+    int channel;
+    float value_change;
+    int no_change_interval;
+    int interval_min;
+    int interval_max;
+
+    if (!config_channel_get(payload, &channel))
+    {
+        return;
+    }
+
+    config_sensor_t values = *config_sensor_get(sub->number, channel);
+    value_t current = { .raw = values.value_change, .decimals = config_sensor_decimals(sub->number) };
+
+    value_change = value_to_float(&current);
+    no_change_interval = values.no_change_interval;
+    interval_min = values.interval_min;
+    interval_max = values.interval_max;
+
+    usb_talk_payload_get_key_float(payload, "value-change", &value_change);
+    usb_talk_payload_get_key_int(payload, "no-change-interval", &no_change_interval);
+    usb_talk_payload_get_key_int(payload, "interval-min", &interval_min);
+    usb_talk_payload_get_key_int(payload, "interval-max", &interval_max);
+
+    if ((value_change < 0.f) || (no_change_interval < 1) || (no_change_interval > UINT16_MAX) ||
+            (interval_min < 1) || (interval_max < interval_min) || (interval_max > UINT16_MAX))
+    {
+        return;
+    }
+
+    values.value_change = value_from_float(value_change, current.decimals, VALUE_UNIT_NONE).raw;
+    values.no_change_interval = no_change_interval;
+    values.interval_min = interval_min;
+    values.interval_max = interval_max;
+
+    if (!config_sensor_set(sub->number, channel, &values))
+    {
+        return;
+    }
+
+    sensors_apply_config();
+
+    config_publish(sub->number, channel);
+}
+
+static void config_get(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+
+    int channel;
+
+    if (!config_channel_get(payload, &channel))
+    {
+        return;
+    }
+
+    config_publish(sub->number, channel);
+}
+
+static void config_reset(uint64_t *id, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub)
+{
+    (void) id;
+
+    int channel;
+
+    if (!config_channel_get(payload, &channel))
+    {
+        return;
+    }
+
+    if (!config_sensor_reset(sub->number, channel))
+    {
+        return;
+    }
+
+    sensors_apply_config();
+
+    config_publish(sub->number, channel);
+}
+
 static void lcd_button_event_handler(bc_button_t *self, bc_button_event_t event, void *event_param)
 {
     (void) event_param;
 
+    bool left = self->_channel.virtual_channel == BC_MODULE_LCD_BUTTON_LEFT;
+
+    // Holding either button takes the LCD back from the host
+    if (event == BC_BUTTON_EVENT_HOLD)
+    {
+        lcd.mqtt = false;
+
+        dashboard_draw();
+        lcd_invalidate();
+
+        return;
+    }
+
     if (event != BC_BUTTON_EVENT_CLICK)
     {
         return;
     }
 
-    if (self->_channel.virtual_channel == BC_MODULE_LCD_BUTTON_LEFT)
+    if (left)
     {
         static uint16_t event_left_count = 0;
         usb_talk_publish_event_count(&my_id, "push-button/lcd:left", &event_left_count);
@@ -1017,6 +1807,12 @@ static void lcd_button_event_handler(bc_button_t *self, bc_button_event_t event,
         usb_talk_publish_event_count(&my_id, "push-button/lcd:right", &event_right_count);
         event_right_count++;
     }
+
+    if (!lcd.mqtt)
+    {
+        dashboard_select(left ? -1 : 1);
+        lcd_invalidate();
+    }
 }
 #endif
 
@@ -1029,5 +1825,8 @@ static void update_vv_display(uint64_t *device_address, usb_talk_payload_t *payl
     }
     packet.type = sub -> number;
 
-    vv_radio_send_update(&packet);
+    uint8_t buffer[VV_RADIO_MESSAGE_SIZE];
+    size_t length = vv_radio_encode_update(&packet, buffer);
+
+    outbox_buffer(device_address, OUTBOX_TARGET_BUFFER(VV_RADIO_SINGLE_FLOAT, packet.type), buffer, length);
 }
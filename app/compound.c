@@ -0,0 +1,164 @@
+#include <compound.h>
+#include <string.h>
+
+static int _compound_palette_find(const uint8_t *palette, int palette_length, const uint8_t *color);
+
+bool compound_encode(const uint8_t *compound, size_t length, uint8_t *packed, size_t *packed_length)
+{
+    uint8_t palette[COMPOUND_PALETTE_SIZE * 4];
+    int palette_length = 0;
+    bool white = false;
+
+    if ((length == 0) || (length % COMPOUND_TUPLE_SIZE != 0))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; i += COMPOUND_TUPLE_SIZE)
+    {
+        const uint8_t *color = compound + i + 1;
+
+        if (color[0] != 0)
+        {
+            white = true;
+        }
+
+        if (_compound_palette_find(palette, palette_length, color) < 0)
+        {
+            if (palette_length == COMPOUND_PALETTE_SIZE)
+            {
+                return false;
+            }
+
+            memcpy(palette + palette_length * 4, color, 4);
+
+            palette_length++;
+        }
+    }
+
+    size_t color_size = white ? 4 : 3;
+    size_t offset = 1 + palette_length * color_size;
+
+    if (offset > *packed_length)
+    {
+        return false;
+    }
+
+    packed[0] = (uint8_t) ((palette_length - 1) | (white ? COMPOUND_FORMAT_WHITE : 0));
+
+    for (int i = 0; i < palette_length; i++)
+    {
+        memcpy(packed + 1 + i * color_size, palette + i * 4 + (white ? 0 : 1), color_size);
+    }
+
+    size_t i = 0;
+
+    while (i < length)
+    {
+        int index = _compound_palette_find(palette, palette_length, compound + i + 1);
+        uint32_t count = 0;
+
+        // Neighbouring tuples of the same color are one run
+        while ((i < length) && (memcmp(compound + i + 1, palette + index * 4, 4) == 0))
+        {
+            count += compound[i];
+
+            i += COMPOUND_TUPLE_SIZE;
+        }
+
+        while (count > 0)
+        {
+            uint8_t run = count > 255 ? 255 : (uint8_t) count;
+
+            if (run <= COMPOUND_RUN_SHORT_MAX)
+            {
+                if (offset + 1 > *packed_length)
+                {
+                    return false;
+                }
+
+                packed[offset++] = (uint8_t) ((index << 4) | (run - 1));
+            }
+            else
+            {
+                if (offset + 2 > *packed_length)
+                {
+                    return false;
+                }
+
+                packed[offset++] = (uint8_t) ((index << 4) | 0x0f);
+                packed[offset++] = run;
+            }
+
+            count -= run;
+        }
+    }
+
+    *packed_length = offset;
+
+    return true;
+}
+
+bool compound_decode(const uint8_t *packed, size_t packed_length, uint8_t *compound, size_t *length)
+{
+    if (packed_length < 1)
+    {
+        return false;
+    }
+
+    int palette_length = (packed[0] & 0x0f) + 1;
+    size_t color_size = (packed[0] & COMPOUND_FORMAT_WHITE) ? 4 : 3;
+    size_t offset = 1 + palette_length * color_size;
+    size_t _length = 0;
+
+    if (offset > packed_length)
+    {
+        return false;
+    }
+
+    while (offset < packed_length)
+    {
+        int index = packed[offset] >> 4;
+        uint8_t count = (packed[offset] & 0x0f) + 1;
+
+        offset++;
+
+        if (count > COMPOUND_RUN_SHORT_MAX)
+        {
+            if (offset == packed_length)
+            {
+                return false;
+            }
+
+            count = packed[offset++];
+        }
+
+        if ((index >= palette_length) || (_length + COMPOUND_TUPLE_SIZE > *length))
+        {
+            return false;
+        }
+
+        compound[_length] = count;
+        compound[_length + 1] = 0;
+        memcpy(compound + _length + 1 + (4 - color_size), packed + 1 + index * color_size, color_size);
+
+        _length += COMPOUND_TUPLE_SIZE;
+    }
+
+    *length = _length;
+
+    return true;
+}
+
+static int _compound_palette_find(const uint8_t *palette, int palette_length, const uint8_t *color)
+{
+    for (int i = 0; i < palette_length; i++)
+    {
+        if (memcmp(palette + i * 4, color, 4) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
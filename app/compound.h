@@ -0,0 +1,25 @@
+#ifndef _COMPOUND_H
+#define _COMPOUND_H
+
+// Packed LED strip compound, shared with the node firmware, depends on the C library only.
+//
+// Plain compound is a list of (COUNT, COLOR[4]) tuples. Packed compound is
+// [FORMAT][PALETTE...][RUN...] where FORMAT holds the number of palette colors - 1
+// in the low nibble and COMPOUND_FORMAT_WHITE when the palette colors carry the white byte,
+// every palette color is 3 or 4 bytes in the same byte order as in the plain compound
+// and every RUN byte holds the palette index in the high nibble and count - 1 in the low nibble,
+// low nibble 0x0f means the count follows in the next byte.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define COMPOUND_TUPLE_SIZE 5
+#define COMPOUND_PALETTE_SIZE 16
+#define COMPOUND_FORMAT_WHITE 0x10
+#define COMPOUND_RUN_SHORT_MAX 15
+
+bool compound_encode(const uint8_t *compound, size_t length, uint8_t *packed, size_t *packed_length);
+bool compound_decode(const uint8_t *packed, size_t packed_length, uint8_t *compound, size_t *length);
+
+#endif
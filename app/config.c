@@ -0,0 +1,226 @@
+#include <config.h>
+#include <usb_talk.h>
+#include <storage.h>
+#include <bcl.h>
+
+#define CONFIG_MAGIC 0xc0f1
+#define CONFIG_VERSION 2
+
+typedef struct
+{
+    uint8_t type;
+    uint8_t channel;
+    uint8_t used;
+    uint8_t reserved;
+    config_sensor_t values;
+
+} config_instance_t;
+
+typedef struct
+{
+    uint16_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    config_sensor_t sensor[SENSOR_TYPE_COUNT];
+    config_instance_t instance[CONFIG_INSTANCE_COUNT];
+
+} config_image_t;
+
+_Static_assert(sizeof(config_image_t) <= CONFIG_EEPROM_SIZE, "config image does not fit its EEPROM region");
+
+static const config_sensor_t _config_default[SENSOR_TYPE_COUNT] = {
+    [SENSOR_TYPE_TEMPERATURE] = {
+        VALUE_FIXED(TEMPERATURE_TAG_PUB_VALUE_CHANGE, VALUE_TEMPERATURE_DECIMALS), TEMPERATURE_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        TEMPERATURE_TAG_UPDATE_INTERVAL_MIN / 1000, TEMPERATURE_TAG_UPDATE_INTERVAL_MAX / 1000
+    },
+    [SENSOR_TYPE_HUMIDITY] = {
+        VALUE_FIXED(HUMIDITY_TAG_PUB_VALUE_CHANGE, VALUE_HUMIDITY_DECIMALS), HUMIDITY_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        HUMIDITY_TAG_UPDATE_INTERVAL_MIN / 1000, HUMIDITY_TAG_UPDATE_INTERVAL_MAX / 1000
+    },
+    [SENSOR_TYPE_LUX_METER] = {
+        VALUE_FIXED(LUX_METER_TAG_PUB_VALUE_CHANGE, VALUE_ILLUMINANCE_DECIMALS), LUX_METER_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        LUX_METER_TAG_UPDATE_INTERVAL_MIN / 1000, LUX_METER_TAG_UPDATE_INTERVAL_MAX / 1000
+    },
+    [SENSOR_TYPE_BAROMETER] = {
+        VALUE_FIXED(BAROMETER_TAG_PUB_VALUE_CHANGE, VALUE_PRESSURE_DECIMALS), BAROMETER_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        BAROMETER_TAG_UPDATE_INTERVAL_MIN / 1000, BAROMETER_TAG_UPDATE_INTERVAL_MAX / 1000
+    },
+    [SENSOR_TYPE_CO2] = {
+        VALUE_FIXED(CO2_PUB_VALUE_CHANGE, VALUE_CONCENTRATION_DECIMALS), CO2_PUB_NO_CHANGE_INTERVAL / 1000,
+        CO2_UPDATE_INTERVAL / 1000, CO2_UPDATE_INTERVAL / 1000
+    }
+};
+
+static const uint8_t _config_decimals[SENSOR_TYPE_COUNT] = {
+    [SENSOR_TYPE_TEMPERATURE] = VALUE_TEMPERATURE_DECIMALS,
+    [SENSOR_TYPE_HUMIDITY] = VALUE_HUMIDITY_DECIMALS,
+    [SENSOR_TYPE_LUX_METER] = VALUE_ILLUMINANCE_DECIMALS,
+    [SENSOR_TYPE_BAROMETER] = VALUE_PRESSURE_DECIMALS,
+    [SENSOR_TYPE_CO2] = VALUE_CONCENTRATION_DECIMALS
+};
+
+// RAM copy of the EEPROM image, sensor handlers read it on every sample.
+// Nothing is written until the first change, an empty EEPROM means defaults.
+static config_image_t _config;
+
+static int _config_instance_find(sensor_type_t type, uint8_t channel);
+static bool _config_store(size_t offset, size_t length);
+static void _config_publish_values(sensor_type_t type, int channel, const config_sensor_t *values);
+
+void config_init(void)
+{
+    bc_eeprom_read(CONFIG_EEPROM_ADDRESS, &_config, sizeof(_config));
+
+    if ((_config.magic != CONFIG_MAGIC) || (_config.version != CONFIG_VERSION))
+    {
+        memset(&_config, 0, sizeof(_config));
+
+        _config.magic = CONFIG_MAGIC;
+        _config.version = CONFIG_VERSION;
+
+        memcpy(_config.sensor, _config_default, sizeof(_config.sensor));
+    }
+}
+
+const config_sensor_t *config_sensor_get(sensor_type_t type, int channel)
+{
+    int index = channel == CONFIG_CHANNEL_CLASS ? -1 : _config_instance_find(type, channel);
+
+    if (index >= 0)
+    {
+        return &_config.instance[index].values;
+    }
+
+    return &_config.sensor[type];
+}
+
+uint8_t config_sensor_decimals(sensor_type_t type)
+{
+    return type < SENSOR_TYPE_COUNT ? _config_decimals[type] : 0;
+}
+
+bool config_sensor_set(sensor_type_t type, int channel, const config_sensor_t *values)
+{
+    if (type >= SENSOR_TYPE_COUNT)
+    {
+        return false;
+    }
+
+    if (channel == CONFIG_CHANNEL_CLASS)
+    {
+        _config.sensor[type] = *values;
+
+        return _config_store(offsetof(config_image_t, sensor) + type * sizeof(config_sensor_t), sizeof(config_sensor_t));
+    }
+
+    int index = _config_instance_find(type, channel);
+
+    if (index < 0)
+    {
+        for (index = 0; (index < CONFIG_INSTANCE_COUNT) && _config.instance[index].used; index++);
+
+        if (index == CONFIG_INSTANCE_COUNT)
+        {
+            return false;
+        }
+    }
+
+    config_instance_t *instance = &_config.instance[index];
+
+    instance->type = type;
+    instance->channel = channel;
+    instance->used = 1;
+    instance->values = *values;
+
+    return _config_store(offsetof(config_image_t, instance) + index * sizeof(config_instance_t), sizeof(config_instance_t));
+}
+
+bool config_sensor_reset(sensor_type_t type, int channel)
+{
+    if (type >= SENSOR_TYPE_COUNT)
+    {
+        return false;
+    }
+
+    if (channel == CONFIG_CHANNEL_CLASS)
+    {
+        return config_sensor_set(type, channel, &_config_default[type]);
+    }
+
+    int index = _config_instance_find(type, channel);
+
+    if (index < 0)
+    {
+        return true;
+    }
+
+    _config.instance[index].used = 0;
+
+    return _config_store(offsetof(config_image_t, instance) + index * sizeof(config_instance_t), sizeof(config_instance_t));
+}
+
+void config_publish(sensor_type_t type, int channel)
+{
+    if (channel != CONFIG_CHANNEL_CLASS)
+    {
+        _config_publish_values(type, channel, config_sensor_get(type, channel));
+
+        return;
+    }
+
+    _config_publish_values(type, CONFIG_CHANNEL_CLASS, &_config.sensor[type]);
+
+    for (int i = 0; i < CONFIG_INSTANCE_COUNT; i++)
+    {
+        if (_config.instance[i].used && (_config.instance[i].type == type))
+        {
+            _config_publish_values(type, _config.instance[i].channel, &_config.instance[i].values);
+        }
+    }
+}
+
+static int _config_instance_find(sensor_type_t type, uint8_t channel)
+{
+    for (int i = 0; i < CONFIG_INSTANCE_COUNT; i++)
+    {
+        if (_config.instance[i].used && (_config.instance[i].type == type) && (_config.instance[i].channel == channel))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static bool _config_store(size_t offset, size_t length)
+{
+    // Header goes first, a record is never valid without it
+    if (!storage_write(CONFIG_EEPROM_ADDRESS, &_config, offsetof(config_image_t, sensor)))
+    {
+        return false;
+    }
+
+    return storage_write(CONFIG_EEPROM_ADDRESS + offset, (uint8_t *) &_config + offset, length);
+}
+
+static void _config_publish_values(sensor_type_t type, int channel, const config_sensor_t *values)
+{
+    const char *name = sensors_get_type_name(type);
+    value_t value_change = { .raw = values->value_change, .decimals = _config_decimals[type] };
+
+    if (channel == CONFIG_CHANNEL_CLASS)
+    {
+        usb_talk_message_start("$config/%s", name);
+    }
+    else
+    {
+        usb_talk_message_start("$config/%s/%d:%d", name, ((channel & 0x80) >> 7), (channel & ~0x80));
+    }
+
+    usb_talk_message_append("{\"value-change\": ");
+    usb_talk_message_append_value(&value_change);
+    usb_talk_message_append(", \"no-change-interval\": %u, ", values->no_change_interval);
+    usb_talk_message_append("\"interval-min\": %u, \"interval-max\": %u}", values->interval_min, values->interval_max);
+
+    usb_talk_message_send();
+}
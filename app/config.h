@@ -0,0 +1,37 @@
+#ifndef _CONFIG_H
+#define _CONFIG_H
+
+#include <bc_common.h>
+#include <sensors.h>
+#include <value.h>
+
+#define CONFIG_EEPROM_ADDRESS 0x10d0
+#define CONFIG_EEPROM_SIZE 0x0100
+#define CONFIG_INSTANCE_COUNT 8
+#define CONFIG_CHANNEL_CLASS (-1)
+
+// Value change is raw fixed point with the class decimals,
+// intervals are in seconds to keep the EEPROM image small
+typedef struct
+{
+    int32_t value_change;
+    uint16_t no_change_interval;
+    uint16_t interval_min;
+    uint16_t interval_max;
+
+} config_sensor_t;
+
+void config_init(void);
+
+// Instance settings when the channel has its own, class settings otherwise
+const config_sensor_t *config_sensor_get(sensor_type_t type, int channel);
+
+uint8_t config_sensor_decimals(sensor_type_t type);
+
+bool config_sensor_set(sensor_type_t type, int channel, const config_sensor_t *values);
+
+bool config_sensor_reset(sensor_type_t type, int channel);
+
+void config_publish(sensor_type_t type, int channel);
+
+#endif
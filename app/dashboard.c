@@ -0,0 +1,266 @@
+#include <dashboard.h>
+#include <stream.h>
+#include <usb_talk.h>
+#include <bc_radio_pub.h>
+#include <bcl.h>
+
+#define DASHBOARD_HEADER_Y 2
+#define DASHBOARD_LINE_Y 16
+#define DASHBOARD_ROW_Y 20
+#define DASHBOARD_ROW_HEIGHT 18
+#define DASHBOARD_LABEL_X 2
+#define DASHBOARD_VALUE_X 64
+
+typedef struct
+{
+    int8_t index;
+    char text[VALUE_FORMAT_LENGTH];
+
+} dashboard_row_t;
+
+static const char *_dashboard_kind_label[STREAM_KIND_COUNT] = {
+    [STREAM_KIND_TEMPERATURE] = "temp",
+    [STREAM_KIND_HUMIDITY] = "hum",
+    [STREAM_KIND_LUX_METER] = "lux",
+    [STREAM_KIND_PRESSURE] = "press",
+    [STREAM_KIND_CO2] = "co2",
+    [STREAM_KIND_VOLTAGE] = "batt"
+};
+
+// One page per node, one row per stream of the node. Every row remembers the text it shows,
+// a new value erases only the old text by drawing it inverted, the rest of the page stays as it is.
+static struct
+{
+    uint64_t node;
+    bool selected;
+    dashboard_row_t row[DASHBOARD_ROW_COUNT];
+    int row_count;
+
+} _dashboard;
+
+static bool _dashboard_node_present(uint64_t node);
+static void _dashboard_label(char *buffer, size_t size, stream_kind_t kind, uint8_t channel);
+
+void dashboard_init(void)
+{
+    memset(&_dashboard, 0, sizeof(_dashboard));
+}
+
+void dashboard_draw(void)
+{
+    uint64_t id;
+    stream_kind_t kind;
+    uint8_t channel;
+    value_t latest;
+    char label[DASHBOARD_LABEL_LENGTH];
+
+    bc_module_lcd_clear();
+
+    _dashboard.row_count = 0;
+
+    if (!_dashboard.selected || !_dashboard_node_present(_dashboard.node))
+    {
+        _dashboard.selected = false;
+
+        for (int i = 0; i < STREAM_COUNT; i++)
+        {
+            if (stream_get(i, &id, &kind, &channel, &latest))
+            {
+                _dashboard.node = id;
+                _dashboard.selected = true;
+
+                break;
+            }
+        }
+    }
+
+    if (!_dashboard.selected)
+    {
+        bc_module_lcd_set_font(&bc_font_ubuntu_13);
+        bc_module_lcd_draw_string(DASHBOARD_LABEL_X, DASHBOARD_ROW_Y, "No data", true);
+
+        return;
+    }
+
+    char header[13];
+
+    snprintf(header, sizeof(header), USB_TALK_DEVICE_ADDRESS, _dashboard.node);
+
+    bc_module_lcd_set_font(&bc_font_ubuntu_11);
+    bc_module_lcd_draw_string(DASHBOARD_LABEL_X, DASHBOARD_HEADER_Y, header, true);
+    bc_module_lcd_draw_line(0, DASHBOARD_LINE_Y, 127, DASHBOARD_LINE_Y, true);
+
+    bc_module_lcd_set_font(&bc_font_ubuntu_13);
+
+    for (int i = 0; (i < STREAM_COUNT) && (_dashboard.row_count < DASHBOARD_ROW_COUNT); i++)
+    {
+        if (!stream_get(i, &id, &kind, &channel, &latest) || (id != _dashboard.node))
+        {
+            continue;
+        }
+
+        dashboard_row_t *row = &_dashboard.row[_dashboard.row_count];
+        int y = DASHBOARD_ROW_Y + _dashboard.row_count * DASHBOARD_ROW_HEIGHT;
+
+        row->index = (int8_t) i;
+
+        _dashboard_label(label, sizeof(label), kind, channel);
+        value_format(row->text, sizeof(row->text), &latest);
+
+        bc_module_lcd_draw_string(DASHBOARD_LABEL_X, y, label, true);
+        bc_module_lcd_draw_string(DASHBOARD_VALUE_X, y, row->text, true);
+
+        _dashboard.row_count++;
+    }
+}
+
+void dashboard_select(int step)
+{
+    uint64_t nodes[STREAM_COUNT];
+    int count = 0;
+    int position = 0;
+    uint64_t id;
+    stream_kind_t kind;
+    uint8_t channel;
+    value_t latest;
+
+    // Nodes in the order their first stream sits in the table
+    for (int i = 0; i < STREAM_COUNT; i++)
+    {
+        if (!stream_get(i, &id, &kind, &channel, &latest))
+        {
+            continue;
+        }
+
+        int j;
+
+        for (j = 0; (j < count) && (nodes[j] != id); j++)
+        {
+            continue;
+        }
+
+        if (j == count)
+        {
+            nodes[count++] = id;
+        }
+
+        if (_dashboard.selected && (id == _dashboard.node))
+        {
+            position = j;
+        }
+    }
+
+    if (count != 0)
+    {
+        position = ((position + step) % count + count) % count;
+
+        _dashboard.node = nodes[position];
+        _dashboard.selected = true;
+    }
+
+    dashboard_draw();
+}
+
+bool dashboard_update(int index)
+{
+    uint64_t id;
+    stream_kind_t kind;
+    uint8_t channel;
+    value_t latest;
+    bool used = stream_get(index, &id, &kind, &channel, &latest);
+
+    for (int i = 0; i < _dashboard.row_count; i++)
+    {
+        dashboard_row_t *row = &_dashboard.row[i];
+
+        if (row->index != index)
+        {
+            continue;
+        }
+
+        // Forgotten or taken over by another node
+        if (!used || (id != _dashboard.node))
+        {
+            dashboard_draw();
+
+            return true;
+        }
+
+        char text[VALUE_FORMAT_LENGTH];
+        int y = DASHBOARD_ROW_Y + i * DASHBOARD_ROW_HEIGHT;
+
+        value_format(text, sizeof(text), &latest);
+
+        if (strcmp(text, row->text) == 0)
+        {
+            return false;
+        }
+
+        bc_module_lcd_set_font(&bc_font_ubuntu_13);
+        bc_module_lcd_draw_string(DASHBOARD_VALUE_X, y, row->text, false);
+        bc_module_lcd_draw_string(DASHBOARD_VALUE_X, y, text, true);
+
+        memcpy(row->text, text, sizeof(row->text));
+
+        return true;
+    }
+
+    if (!used)
+    {
+        return false;
+    }
+
+    // First stream at all or a new stream of the shown node
+    if (!_dashboard.selected || ((id == _dashboard.node) && (_dashboard.row_count < DASHBOARD_ROW_COUNT)))
+    {
+        dashboard_draw();
+
+        return true;
+    }
+
+    return false;
+}
+
+static bool _dashboard_node_present(uint64_t node)
+{
+    uint64_t id;
+    stream_kind_t kind;
+    uint8_t channel;
+    value_t latest;
+
+    for (int i = 0; i < STREAM_COUNT; i++)
+    {
+        if (stream_get(i, &id, &kind, &channel, &latest) && (id == node))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void _dashboard_label(char *buffer, size_t size, stream_kind_t kind, uint8_t channel)
+{
+    const char *name = _dashboard_kind_label[kind];
+
+    if ((kind == STREAM_KIND_CO2) || (kind == STREAM_KIND_VOLTAGE))
+    {
+        snprintf(buffer, size, "%s", name);
+    }
+    else if ((kind == STREAM_KIND_TEMPERATURE) && (channel == BC_RADIO_PUB_CHANNEL_A))
+    {
+        snprintf(buffer, size, "%s a", name);
+    }
+    else if ((kind == STREAM_KIND_TEMPERATURE) && (channel == BC_RADIO_PUB_CHANNEL_B))
+    {
+        snprintf(buffer, size, "%s b", name);
+    }
+    else if ((kind == STREAM_KIND_TEMPERATURE) && (channel == BC_RADIO_PUB_CHANNEL_SET_POINT))
+    {
+        snprintf(buffer, size, "%s sp", name);
+    }
+    else
+    {
+        snprintf(buffer, size, "%s %d:%d", name, ((channel & 0x80) >> 7), (channel & ~0x80));
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef _DASHBOARD_H
+#define _DASHBOARD_H
+
+#include <bc_common.h>
+
+#define DASHBOARD_ROW_COUNT 6
+#define DASHBOARD_LABEL_LENGTH 12
+
+void dashboard_init(void);
+
+// Redraws the whole page of the selected node
+void dashboard_draw(void);
+
+// Moves the selection by step nodes, wraps around
+void dashboard_select(int step);
+
+// Draws what changed after the stream at index was updated, returns true when the framebuffer changed
+bool dashboard_update(int index);
+
+#endif
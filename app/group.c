@@ -0,0 +1,309 @@
+#include <group.h>
+#include <outbox.h>
+#include <radio.h>
+#include <storage.h>
+#include <usb_talk.h>
+#include <bcl.h>
+
+typedef struct
+{
+    char name[GROUP_NAME_LENGTH + 1];
+    uint8_t count;
+    uint8_t reserved[7];
+    uint64_t member[GROUP_MEMBER_COUNT];
+
+} group_record_t;
+
+// Groups live only in EEPROM, it is memory mapped so reading a record on every
+// expanded command is cheap and the gateway does not spend RAM on them,
+// reads go through storage to see the writes still queued
+#define GROUP_ADDRESS(group) (GROUP_EEPROM_ADDRESS + (group) * sizeof(group_record_t))
+#define GROUP_COUNT_ADDRESS(group) (GROUP_ADDRESS(group) + offsetof(group_record_t, count))
+#define GROUP_MEMBER_ADDRESS(group, index) (GROUP_ADDRESS(group) + offsetof(group_record_t, member) + (index) * sizeof(uint64_t))
+
+_Static_assert(GROUP_COUNT * sizeof(group_record_t) <= GROUP_EEPROM_SIZE, "group records do not fit their EEPROM region");
+
+static bool _group_name_valid(const char *name);
+static int _group_get_count(int group);
+static int _group_find_member(int group, uint64_t *id);
+static void _group_join(int group, uint64_t *id, int member);
+static void _group_leave_all(int group);
+
+int group_find(const char *name, size_t length)
+{
+    char stored[GROUP_NAME_LENGTH + 1];
+
+    if ((length == 0) || (length > GROUP_NAME_LENGTH))
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < GROUP_COUNT; i++)
+    {
+        storage_read(GROUP_ADDRESS(i), stored, sizeof(stored));
+
+        if ((strncmp(stored, name, length) == 0) && (stored[length] == 0))
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool group_get_member(int group, int index, uint64_t *id)
+{
+    if (index >= _group_get_count(group))
+    {
+        return false;
+    }
+
+    storage_read(GROUP_MEMBER_ADDRESS(group, index), id, sizeof(*id));
+
+    return true;
+}
+
+bool group_add(const char *name, uint64_t *id)
+{
+    if (!_group_name_valid(name))
+    {
+        return false;
+    }
+
+    int group = group_find(name, strlen(name));
+
+    if (group < 0)
+    {
+        for (int i = 0; i < GROUP_COUNT; i++)
+        {
+            char first;
+
+            storage_read(GROUP_ADDRESS(i), &first, sizeof(first));
+
+            if (first == 0)
+            {
+                group = i;
+
+                break;
+            }
+        }
+
+        if (group < 0)
+        {
+            return false;
+        }
+
+        group_record_t record;
+
+        memset(&record, 0, offsetof(group_record_t, member));
+        memcpy(record.name, name, strlen(name));
+
+        if (!storage_write(GROUP_ADDRESS(group), &record, offsetof(group_record_t, member)))
+        {
+            return false;
+        }
+    }
+
+    if (_group_find_member(group, id) >= 0)
+    {
+        return true;
+    }
+
+    uint8_t count = _group_get_count(group);
+
+    if (count == GROUP_MEMBER_COUNT)
+    {
+        return false;
+    }
+
+    if (!storage_write(GROUP_MEMBER_ADDRESS(group, count), id, sizeof(*id)))
+    {
+        return false;
+    }
+
+    uint8_t member = count++;
+
+    if (!storage_write(GROUP_COUNT_ADDRESS(group), &count, sizeof(count)))
+    {
+        return false;
+    }
+
+    _group_join(group, id, member);
+
+    return true;
+}
+
+bool group_remove(const char *name, uint64_t *id)
+{
+    int group = group_find(name, strlen(name));
+
+    if (group < 0)
+    {
+        return false;
+    }
+
+    if (id == NULL)
+    {
+        _group_leave_all(group);
+
+        uint8_t empty[offsetof(group_record_t, member)];
+
+        memset(empty, 0, sizeof(empty));
+
+        return storage_write(GROUP_ADDRESS(group), empty, sizeof(empty));
+    }
+
+    int index = _group_find_member(group, id);
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    uint8_t count = _group_get_count(group) - 1;
+
+    // Move the last member into the hole, the order of members does not matter
+    if (index != count)
+    {
+        uint64_t last;
+
+        storage_read(GROUP_MEMBER_ADDRESS(group, count), &last, sizeof(last));
+
+        if (!storage_write(GROUP_MEMBER_ADDRESS(group, index), &last, sizeof(last)))
+        {
+            return false;
+        }
+
+        _group_join(group, &last, index);
+    }
+
+    _group_join(group, id, GROUP_MEMBER_NONE);
+
+    return storage_write(GROUP_COUNT_ADDRESS(group), &count, sizeof(count));
+}
+
+void group_list(void)
+{
+    char name[GROUP_NAME_LENGTH + 1];
+    bool empty = true;
+
+    usb_talk_message_start("$eeprom/group/list");
+
+    usb_talk_message_append("{");
+
+    for (int i = 0; i < GROUP_COUNT; i++)
+    {
+        storage_read(GROUP_ADDRESS(i), name, sizeof(name));
+
+        if (name[0] == 0)
+        {
+            continue;
+        }
+
+        name[GROUP_NAME_LENGTH] = 0;
+
+        usb_talk_message_append(empty ? "\"%s\": [" : ", \"%s\": [", name);
+
+        uint64_t id;
+
+        for (int j = 0; group_get_member(i, j, &id); j++)
+        {
+            usb_talk_message_append(j == 0 ? "\"" USB_TALK_DEVICE_ADDRESS "\"" : ", \"" USB_TALK_DEVICE_ADDRESS "\"", id);
+        }
+
+        usb_talk_message_append("]");
+
+        empty = false;
+    }
+
+    usb_talk_message_append("}");
+
+    usb_talk_message_send();
+}
+
+static bool _group_name_valid(const char *name)
+{
+    size_t length = strlen(name);
+
+    if ((length == 0) || (length > GROUP_NAME_LENGTH))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (!isalnum((unsigned char) name[i]) && (name[i] != '-') && (name[i] != '_'))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int _group_get_count(int group)
+{
+    uint8_t count = 0;
+
+    storage_read(GROUP_COUNT_ADDRESS(group), &count, sizeof(count));
+
+    return count > GROUP_MEMBER_COUNT ? GROUP_MEMBER_COUNT : count;
+}
+
+static int _group_find_member(int group, uint64_t *id)
+{
+    uint64_t member;
+
+    for (int i = 0; group_get_member(group, i, &member); i++)
+    {
+        if (member == *id)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static void _group_join(int group, uint64_t *id, int member)
+{
+    uint8_t buffer[1 + sizeof(uint64_t) + 2];
+
+    if (!GROUP_BROADCAST)
+    {
+        return;
+    }
+
+    buffer[0] = RADIO_GROUP_JOIN;
+    memcpy(buffer + 1, id, sizeof(uint64_t));
+    buffer[1 + sizeof(uint64_t)] = (uint8_t) group;
+    buffer[2 + sizeof(uint64_t)] = (uint8_t) member;
+
+    // Latest wins per group, a sleeping node learns where it ended up the next time it is heard
+    outbox_buffer(id, OUTBOX_TARGET_BUFFER(RADIO_GROUP_JOIN, group), buffer, sizeof(buffer));
+}
+
+// One broadcast instead of a leave per member, those would push real commands out of the outbox
+static void _group_leave_all(int group)
+{
+    uint8_t buffer[1 + sizeof(uint64_t) + 2];
+    uint64_t member;
+
+    if (!GROUP_BROADCAST)
+    {
+        return;
+    }
+
+    for (int i = 0; group_get_member(group, i, &member); i++)
+    {
+        outbox_remove(&member, OUTBOX_TARGET_BUFFER(RADIO_GROUP_JOIN, group), OUTBOX_TARGET_ALL);
+    }
+
+    memset(buffer, 0, sizeof(buffer));
+
+    buffer[0] = RADIO_GROUP_JOIN;
+    buffer[1 + sizeof(uint64_t)] = (uint8_t) group;
+    buffer[2 + sizeof(uint64_t)] = GROUP_MEMBER_NONE;
+
+    bc_radio_pub_buffer(buffer, sizeof(buffer));
+}
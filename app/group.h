@@ -0,0 +1,25 @@
+#ifndef _GROUP_H
+#define _GROUP_H
+
+#include <bc_common.h>
+
+// Off unless the node firmware understands RADIO_GROUP_JOIN and RADIO_GROUP_STATE_SET,
+// without it a group command is expanded to a plain command per member
+#ifndef GROUP_BROADCAST
+#define GROUP_BROADCAST 0
+#endif
+
+#define GROUP_COUNT 8
+#define GROUP_NAME_LENGTH 15
+#define GROUP_MEMBER_COUNT 24
+#define GROUP_EEPROM_ADDRESS 0x0a10
+#define GROUP_EEPROM_SIZE 0x06c0
+#define GROUP_MEMBER_NONE 0xff
+
+int group_find(const char *name, size_t length);
+bool group_get_member(int group, int index, uint64_t *id);
+bool group_add(const char *name, uint64_t *id);
+bool group_remove(const char *name, uint64_t *id);
+void group_list(void);
+
+#endif
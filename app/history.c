@@ -0,0 +1,313 @@
+#include <history.h>
+#include <usb_talk.h>
+#include <timestamp.h>
+#include <bcl.h>
+
+// Largest record: stream index + time delta + value delta, both as 32-bit varints
+#define HISTORY_RECORD_SIZE_MAX (1 + 5 + 5)
+
+typedef struct
+{
+    uint64_t id;
+    int32_t head_value;
+    int32_t tail_value;
+    uint32_t head_tick;
+    uint16_t records;
+    uint8_t kind;
+    uint8_t channel;
+    uint8_t decimals;
+    uint8_t unit;
+    bool used;
+
+} history_stream_t;
+
+// Records are appended to a byte ring as (stream index, time delta, value delta),
+// deltas are varints so a steady sensor costs three bytes per record.
+// Head keeps the last written values, tail keeps the base the oldest record applies to,
+// evicting a record moves its deltas into the tail so the chain stays decodable.
+static struct
+{
+    uint8_t buffer[HISTORY_BUFFER_SIZE];
+    size_t tail;
+    size_t length;
+    uint32_t head_tick;
+    uint32_t tail_tick;
+    history_stream_t stream[HISTORY_STREAM_COUNT];
+    uint32_t records;
+    uint32_t evicted;
+    uint32_t dropped;
+
+} _history;
+
+static int _history_stream_find(uint64_t *id, stream_kind_t kind, uint8_t channel);
+static size_t _history_varint_encode(uint8_t *buffer, uint32_t value);
+static size_t _history_record_read(size_t offset, uint8_t *index, uint32_t *tick_delta, int32_t *value_delta);
+static int _history_evict(void);
+
+void history_init(void)
+{
+    memset(&_history, 0, sizeof(_history));
+}
+
+void history_record(uint64_t *id, stream_kind_t kind, uint8_t channel, const value_t *value)
+{
+    int index = _history_stream_find(id, kind, channel);
+
+    if (index < 0)
+    {
+        _history.dropped++;
+
+        return;
+    }
+
+    history_stream_t *stream = &_history.stream[index];
+    int32_t fixed = value->raw;
+    uint32_t tick = (uint32_t) (timestamp_get() / HISTORY_TICK_UNIT);
+
+    // Unchanged values are only kept as a heartbeat
+    if ((fixed == stream->head_value) && (stream->head_tick != 0) && ((tick - stream->head_tick) < (HISTORY_HEARTBEAT / HISTORY_TICK_UNIT)))
+    {
+        return;
+    }
+
+    uint8_t record[HISTORY_RECORD_SIZE_MAX];
+    int32_t delta = fixed - stream->head_value;
+    size_t length = 0;
+
+    record[length++] = (uint8_t) index;
+    length += _history_varint_encode(record + length, tick - _history.head_tick);
+    length += _history_varint_encode(record + length, ((uint32_t) delta << 1) ^ (uint32_t) (delta >> 31));
+
+    while (HISTORY_BUFFER_SIZE - _history.length < length)
+    {
+        _history_evict();
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+        _history.buffer[(_history.tail + _history.length + i) % HISTORY_BUFFER_SIZE] = record[i];
+    }
+
+    _history.length += length;
+    _history.head_tick = tick;
+    _history.records++;
+
+    // Evicting above may have taken the last record of this very stream
+    stream->used = true;
+    stream->records++;
+    stream->head_value = fixed;
+    stream->head_tick = tick;
+    stream->decimals = value->decimals;
+    stream->unit = value->unit;
+}
+
+void history_publish(bc_tick_t from, bc_tick_t to)
+{
+    uint32_t count = 0;
+
+    for (int index = 0; index < HISTORY_STREAM_COUNT; index++)
+    {
+        history_stream_t *stream = &_history.stream[index];
+
+        if (!stream->used)
+        {
+            continue;
+        }
+
+        uint32_t tick = _history.tail_tick;
+        value_t value = { .raw = stream->tail_value, .decimals = stream->decimals, .unit = stream->unit };
+        size_t offset = 0;
+        bool empty = true;
+
+        while (offset < _history.length)
+        {
+            uint8_t record_index;
+            uint32_t tick_delta;
+            int32_t value_delta;
+
+            offset += _history_record_read(offset, &record_index, &tick_delta, &value_delta);
+
+            tick += tick_delta;
+
+            if (record_index != index)
+            {
+                continue;
+            }
+
+            value.raw += value_delta;
+
+            bc_tick_t time = (bc_tick_t) tick * HISTORY_TICK_UNIT;
+
+            if ((time < from) || (time > to))
+            {
+                continue;
+            }
+
+            if (empty)
+            {
+                char topic[STREAM_TOPIC_LENGTH];
+
+                stream_format_topic(topic, sizeof(topic), stream->kind, stream->channel);
+
+                usb_talk_message_start_id(&stream->id, "%s/history", topic);
+
+                usb_talk_message_append("[");
+            }
+
+            usb_talk_message_append(empty ? "[%lu, " : ", [%lu, ", (unsigned long) time);
+            usb_talk_message_append_value(&value);
+            usb_talk_message_append("]");
+
+            empty = false;
+
+            count++;
+        }
+
+        if (!empty)
+        {
+            usb_talk_message_append("]");
+
+            usb_talk_message_send();
+        }
+    }
+
+    usb_talk_send_format("[\"/history\", {\"uptime\": %lu, \"records\": %lu, \"stored\": %lu, \"evicted\": %lu, \"dropped\": %lu}]\n",
+            (unsigned long) bc_tick_get(), (unsigned long) count, (unsigned long) (_history.records - _history.evicted),
+            (unsigned long) _history.evicted, (unsigned long) _history.dropped);
+}
+
+static int _history_stream_find(uint64_t *id, stream_kind_t kind, uint8_t channel)
+{
+    int free = -1;
+
+    for (int i = 0; i < HISTORY_STREAM_COUNT; i++)
+    {
+        history_stream_t *stream = &_history.stream[i];
+
+        if (!stream->used)
+        {
+            if (free < 0)
+            {
+                free = i;
+            }
+
+            continue;
+        }
+
+        if ((stream->id == *id) && (stream->kind == kind) && (stream->channel == channel))
+        {
+            return i;
+        }
+    }
+
+    // All slots taken, a stream without even a heartbeat for two periods is gone
+    // and the oldest records make room until a slot frees
+    if (free < 0)
+    {
+        uint32_t tick = (uint32_t) (bc_tick_get() / HISTORY_TICK_UNIT);
+        bool stale = false;
+
+        for (int i = 0; i < HISTORY_STREAM_COUNT; i++)
+        {
+            if ((tick - _history.stream[i].head_tick) > (2 * HISTORY_HEARTBEAT / HISTORY_TICK_UNIT))
+            {
+                stale = true;
+            }
+        }
+
+        while (stale && (free < 0) && (_history.length > 0))
+        {
+            free = _history_evict();
+        }
+    }
+
+    // A slot is free again once its last record left the ring, no record refers to its index any more
+    if (free >= 0)
+    {
+        memset(&_history.stream[free], 0, sizeof(_history.stream[free]));
+
+        _history.stream[free].id = *id;
+        _history.stream[free].kind = kind;
+        _history.stream[free].channel = channel;
+        _history.stream[free].used = true;
+    }
+
+    return free;
+}
+
+static size_t _history_varint_encode(uint8_t *buffer, uint32_t value)
+{
+    size_t length = 0;
+
+    while (value >= 0x80)
+    {
+        buffer[length++] = (uint8_t) (value | 0x80);
+
+        value >>= 7;
+    }
+
+    buffer[length++] = (uint8_t) value;
+
+    return length;
+}
+
+static size_t _history_varint_read(size_t offset, uint32_t *value)
+{
+    size_t length = 0;
+    uint8_t byte;
+
+    *value = 0;
+
+    do
+    {
+        byte = _history.buffer[(_history.tail + offset + length) % HISTORY_BUFFER_SIZE];
+
+        *value |= (uint32_t) (byte & 0x7f) << (7 * length);
+
+        length++;
+    }
+    while (byte & 0x80);
+
+    return length;
+}
+
+static size_t _history_record_read(size_t offset, uint8_t *index, uint32_t *tick_delta, int32_t *value_delta)
+{
+    size_t length = 1;
+    uint32_t zigzag;
+
+    *index = _history.buffer[(_history.tail + offset) % HISTORY_BUFFER_SIZE];
+
+    length += _history_varint_read(offset + length, tick_delta);
+    length += _history_varint_read(offset + length, &zigzag);
+
+    *value_delta = (int32_t) (zigzag >> 1) ^ -(int32_t) (zigzag & 1);
+
+    return length;
+}
+
+// Returns the stream slot the evicted record freed, -1 when the stream still has records in the ring
+static int _history_evict(void)
+{
+    uint8_t index;
+    uint32_t tick_delta;
+    int32_t value_delta;
+
+    size_t length = _history_record_read(0, &index, &tick_delta, &value_delta);
+
+    _history.tail_tick += tick_delta;
+    _history.stream[index].tail_value += value_delta;
+
+    _history.tail = (_history.tail + length) % HISTORY_BUFFER_SIZE;
+    _history.length -= length;
+    _history.evicted++;
+
+    if (--_history.stream[index].records == 0)
+    {
+        _history.stream[index].used = false;
+
+        return index;
+    }
+
+    return -1;
+}
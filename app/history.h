@@ -0,0 +1,20 @@
+#ifndef _HISTORY_H
+#define _HISTORY_H
+
+#include <bc_common.h>
+#include <stream.h>
+
+#define HISTORY_BUFFER_SIZE 2048
+#define HISTORY_STREAM_COUNT 16
+#define HISTORY_TICK_UNIT 100
+#define HISTORY_HEARTBEAT (5 * 60 * 1000)
+
+void history_init(void);
+
+void history_record(uint64_t *id, stream_kind_t kind, uint8_t channel, const value_t *value);
+
+// Streams all records between from and to (gateway uptime in milliseconds), one frame per stream,
+// /history/get takes both in seconds
+void history_publish(bc_tick_t from, bc_tick_t to);
+
+#endif
@@ -0,0 +1,331 @@
+#include <lcd_remote.h>
+#include <node_table.h>
+#include <outbox.h>
+#include <radio.h>
+#include <profile.h>
+#include <bcl.h>
+
+// HEAD + ADDRESS + X + Y + FONT_SIZE + COLOR + LENGTH + TEXT, same limit for the batched packet
+#define LCD_REMOTE_BUFFER_SIZE (1 + sizeof(uint64_t) + 5 + LCD_REMOTE_TEXT_LENGTH)
+#define LCD_REMOTE_HEAD_SIZE (1 + sizeof(uint64_t))
+#define LCD_REMOTE_REGION_HEAD_SIZE 4
+
+typedef struct
+{
+    uint32_t hash;
+    uint32_t sent;
+    int8_t slot;
+    uint8_t x;
+    uint8_t y;
+    uint8_t format;
+
+} lcd_remote_region_t;
+
+typedef struct
+{
+    uint8_t x;
+    uint8_t y;
+    uint8_t format;
+    uint8_t length;
+    const char *text;
+
+} lcd_remote_text_t;
+
+// The gateway remembers what it last sent to each text position of every node
+// and skips texts that did not change. A text is remembered once the outbox took
+// it. With LCD_REMOTE_BATCH changed texts sent in a quick sequence to the same node
+// are packed into one RADIO_LCD_TEXTS_SET packet.
+static struct
+{
+    lcd_remote_region_t region[LCD_REMOTE_SHADOW_SIZE];
+    int next_victim;
+
+    bc_scheduler_task_id_t task_id;
+    uint64_t batch_id;
+    uint8_t batch[LCD_REMOTE_BUFFER_SIZE];
+    size_t batch_length;
+    int batch_count;
+    uint16_t batch_sequence;
+
+} _lcd_remote;
+
+static void _lcd_remote_task(void *param);
+static void _lcd_remote_flush(void);
+static bool _lcd_remote_batch_find(uint64_t *id, lcd_remote_text_t *text);
+static lcd_remote_region_t *_lcd_remote_shadow_find(int slot, lcd_remote_text_t *text);
+static bool _lcd_remote_shadow_changed(uint64_t *id, lcd_remote_text_t *text);
+static void _lcd_remote_shadow_commit(uint64_t *id, lcd_remote_text_t *text);
+static void _lcd_remote_shadow_forget(int slot);
+static uint32_t _lcd_remote_hash(const char *text, size_t length);
+
+void lcd_remote_init(void)
+{
+    memset(&_lcd_remote, 0, sizeof(_lcd_remote));
+
+    for (int i = 0; i < LCD_REMOTE_SHADOW_SIZE; i++)
+    {
+        _lcd_remote.region[i].slot = NODE_TABLE_SLOT_NONE;
+    }
+
+    _lcd_remote.task_id = PROFILE_REGISTER(_lcd_remote_task, NULL, BC_TICK_INFINITY);
+}
+
+void lcd_remote_text_set(uint64_t *id, int x, int y, int font_size, bool color, const char *text, size_t length)
+{
+    lcd_remote_text_t region = {
+        .x = (uint8_t) x,
+        .y = (uint8_t) y,
+        .format = (uint8_t) ((font_size & 0x7f) | (color ? 0x80 : 0x00)),
+        .length = (uint8_t) (length > LCD_REMOTE_TEXT_LENGTH ? LCD_REMOTE_TEXT_LENGTH : length),
+        .text = text
+    };
+
+    // The node draws in order, a new text for a position already in the batch goes after it
+    if (_lcd_remote_batch_find(id, &region))
+    {
+        _lcd_remote_flush();
+    }
+
+    if (!_lcd_remote_shadow_changed(id, &region))
+    {
+        return;
+    }
+
+    if ((_lcd_remote.batch_count > 0) && ((_lcd_remote.batch_id != *id) || (_lcd_remote.batch_length + LCD_REMOTE_REGION_HEAD_SIZE + region.length > sizeof(_lcd_remote.batch))))
+    {
+        _lcd_remote_flush();
+    }
+
+    if (_lcd_remote.batch_count == 0)
+    {
+        _lcd_remote.batch_id = *id;
+        _lcd_remote.batch[0] = RADIO_LCD_TEXTS_SET;
+        memcpy(_lcd_remote.batch + 1, id, sizeof(uint64_t));
+        _lcd_remote.batch_length = LCD_REMOTE_HEAD_SIZE;
+
+        bc_scheduler_plan_relative(_lcd_remote.task_id, LCD_REMOTE_BATCH_DELAY);
+    }
+
+    uint8_t *p = _lcd_remote.batch + _lcd_remote.batch_length;
+
+    p[0] = region.x;
+    p[1] = region.y;
+    p[2] = region.format;
+    p[3] = region.length;
+    memcpy(p + LCD_REMOTE_REGION_HEAD_SIZE, region.text, region.length);
+
+    _lcd_remote.batch_length += LCD_REMOTE_REGION_HEAD_SIZE + region.length;
+    _lcd_remote.batch_count++;
+
+#if !LCD_REMOTE_BATCH
+    _lcd_remote_flush();
+#endif
+}
+
+void lcd_remote_screen_clear(uint64_t *id)
+{
+    // Pending texts would be erased by the clear anyway
+    if ((_lcd_remote.batch_count > 0) && (_lcd_remote.batch_id == *id))
+    {
+        _lcd_remote.batch_count = 0;
+    }
+
+    outbox_remove(id, OUTBOX_TARGET_BUFFER(RADIO_LCD_TEXT_SET, 0), OUTBOX_TARGET_HEADER_MASK);
+    outbox_remove(id, OUTBOX_TARGET_BUFFER(RADIO_LCD_TEXTS_SET, 0), OUTBOX_TARGET_HEADER_MASK);
+
+    lcd_remote_forget(id);
+
+    uint8_t buffer[LCD_REMOTE_HEAD_SIZE];
+    buffer[0] = RADIO_LCD_SCREEN_CLEAR;
+    memcpy(buffer + 1, id, sizeof(uint64_t));
+
+    outbox_buffer(id, OUTBOX_TARGET_BUFFER(RADIO_LCD_SCREEN_CLEAR, 0), buffer, sizeof(buffer));
+}
+
+void lcd_remote_forget(uint64_t *id)
+{
+    int slot = node_table_find(*id);
+
+    if (slot != NODE_TABLE_SLOT_NONE)
+    {
+        _lcd_remote_shadow_forget(slot);
+    }
+}
+
+static void _lcd_remote_task(void *param)
+{
+    (void) param;
+
+    _lcd_remote_flush();
+}
+
+static void _lcd_remote_flush(void)
+{
+    if (_lcd_remote.batch_count == 0)
+    {
+        return;
+    }
+
+    uint8_t *region = _lcd_remote.batch + LCD_REMOTE_HEAD_SIZE;
+    bool sent;
+
+    if (_lcd_remote.batch_count == 1)
+    {
+        // Single text goes in the classic packet understood by every node firmware
+        uint8_t buffer[LCD_REMOTE_BUFFER_SIZE];
+        uint8_t length = region[3];
+
+        buffer[0] = RADIO_LCD_TEXT_SET;
+        memcpy(buffer + 1, &_lcd_remote.batch_id, sizeof(uint64_t));
+        buffer[sizeof(uint64_t) + 1] = region[0];
+        buffer[sizeof(uint64_t) + 2] = region[1];
+        buffer[sizeof(uint64_t) + 3] = region[2] & 0x7f;
+        buffer[sizeof(uint64_t) + 4] = (region[2] & 0x80) ? 1 : 0;
+        buffer[sizeof(uint64_t) + 5] = length;
+        memcpy(buffer + sizeof(uint64_t) + 6, region + LCD_REMOTE_REGION_HEAD_SIZE, length);
+
+        sent = outbox_buffer(&_lcd_remote.batch_id, OUTBOX_TARGET_BUFFER(RADIO_LCD_TEXT_SET, (region[0] << 8) | region[1]), buffer, sizeof(uint64_t) + 6 + length);
+    }
+    else
+    {
+        // Packs of several texts cannot replace each other, every one gets its own outbox target
+        sent = outbox_buffer(&_lcd_remote.batch_id, OUTBOX_TARGET_BUFFER(RADIO_LCD_TEXTS_SET, _lcd_remote.batch_sequence++), _lcd_remote.batch, _lcd_remote.batch_length);
+    }
+
+    // A text that did not go out has to be sent again even when it repeats
+    for (int i = 0; sent && (i < _lcd_remote.batch_count); i++)
+    {
+        lcd_remote_text_t text = {
+            .x = region[0],
+            .y = region[1],
+            .format = region[2],
+            .length = region[3],
+            .text = (const char *) region + LCD_REMOTE_REGION_HEAD_SIZE
+        };
+
+        _lcd_remote_shadow_commit(&_lcd_remote.batch_id, &text);
+
+        region += LCD_REMOTE_REGION_HEAD_SIZE + text.length;
+    }
+
+    _lcd_remote.batch_count = 0;
+}
+
+static bool _lcd_remote_batch_find(uint64_t *id, lcd_remote_text_t *text)
+{
+    if ((_lcd_remote.batch_count == 0) || (_lcd_remote.batch_id != *id))
+    {
+        return false;
+    }
+
+    uint8_t *region = _lcd_remote.batch + LCD_REMOTE_HEAD_SIZE;
+
+    for (int i = 0; i < _lcd_remote.batch_count; i++)
+    {
+        if ((region[0] == text->x) && (region[1] == text->y))
+        {
+            return true;
+        }
+
+        region += LCD_REMOTE_REGION_HEAD_SIZE + region[3];
+    }
+
+    return false;
+}
+
+static lcd_remote_region_t *_lcd_remote_shadow_find(int slot, lcd_remote_text_t *text)
+{
+    for (int i = 0; i < LCD_REMOTE_SHADOW_SIZE; i++)
+    {
+        lcd_remote_region_t *region = &_lcd_remote.region[i];
+
+        if ((region->slot == slot) && (region->x == text->x) && (region->y == text->y))
+        {
+            return region;
+        }
+    }
+
+    return NULL;
+}
+
+static bool _lcd_remote_shadow_changed(uint64_t *id, lcd_remote_text_t *text)
+{
+    int slot = node_table_find(*id);
+
+    if (slot == NODE_TABLE_SLOT_NONE)
+    {
+        return true;
+    }
+
+    lcd_remote_region_t *region = _lcd_remote_shadow_find(slot, text);
+    uint32_t now = (uint32_t) bc_tick_get();
+
+    // Refresh now and then even without change, the node may have restarted meanwhile
+    return (region == NULL) || (region->hash != _lcd_remote_hash(text->text, text->length)) ||
+           (region->format != text->format) || (now - region->sent >= LCD_REMOTE_SHADOW_REFRESH);
+}
+
+static void _lcd_remote_shadow_commit(uint64_t *id, lcd_remote_text_t *text)
+{
+    int slot = node_table_find(*id);
+
+    if (slot == NODE_TABLE_SLOT_NONE)
+    {
+        return;
+    }
+
+    lcd_remote_region_t *region = _lcd_remote_shadow_find(slot, text);
+
+    if (region == NULL)
+    {
+        region = &_lcd_remote.region[_lcd_remote.next_victim];
+
+        for (int i = 0; i < LCD_REMOTE_SHADOW_SIZE; i++)
+        {
+            if (_lcd_remote.region[i].slot == NODE_TABLE_SLOT_NONE)
+            {
+                region = &_lcd_remote.region[i];
+
+                break;
+            }
+        }
+
+        if (region == &_lcd_remote.region[_lcd_remote.next_victim])
+        {
+            _lcd_remote.next_victim = (_lcd_remote.next_victim + 1) % LCD_REMOTE_SHADOW_SIZE;
+        }
+
+        region->slot = (int8_t) slot;
+        region->x = text->x;
+        region->y = text->y;
+    }
+
+    region->hash = _lcd_remote_hash(text->text, text->length);
+    region->format = text->format;
+    region->sent = (uint32_t) bc_tick_get();
+}
+
+static void _lcd_remote_shadow_forget(int slot)
+{
+    for (int i = 0; i < LCD_REMOTE_SHADOW_SIZE; i++)
+    {
+        if (_lcd_remote.region[i].slot == slot)
+        {
+            _lcd_remote.region[i].slot = NODE_TABLE_SLOT_NONE;
+        }
+    }
+}
+
+static uint32_t _lcd_remote_hash(const char *text, size_t length)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= (uint8_t) text[i];
+        hash *= 16777619UL;
+    }
+
+    return hash;
+}
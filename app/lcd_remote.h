@@ -0,0 +1,21 @@
+#ifndef _LCD_REMOTE_H
+#define _LCD_REMOTE_H
+
+#include <bc_common.h>
+
+// Off unless the node firmware understands RADIO_LCD_TEXTS_SET
+#ifndef LCD_REMOTE_BATCH
+#define LCD_REMOTE_BATCH 0
+#endif
+
+#define LCD_REMOTE_SHADOW_SIZE 48
+#define LCD_REMOTE_SHADOW_REFRESH (5 * 60 * 1000)
+#define LCD_REMOTE_BATCH_DELAY 20
+#define LCD_REMOTE_TEXT_LENGTH 32
+
+void lcd_remote_init(void);
+void lcd_remote_text_set(uint64_t *id, int x, int y, int font_size, bool color, const char *text, size_t length);
+void lcd_remote_screen_clear(uint64_t *id);
+void lcd_remote_forget(uint64_t *id);
+
+#endif
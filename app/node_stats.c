@@ -0,0 +1,157 @@
+#include <node_stats.h>
+#include <node_table.h>
+#include <usb_talk.h>
+#include <bcl.h>
+
+typedef struct
+{
+    uint32_t last_seen;
+    uint16_t packets[NODE_STATS_PACKET_COUNT];
+    uint16_t event_count[NODE_STATS_EVENT_ID_COUNT];
+    uint16_t lost;
+    uint8_t event_valid;
+    bool seen;
+
+} node_stats_t;
+
+// Indexed by node table slot, so every update is a plain array access
+static node_stats_t _node_stats[NODE_TABLE_SIZE];
+
+// Gateway wide, also counts packets from nodes that are not in the table
+static uint32_t _node_stats_total[NODE_STATS_PACKET_COUNT];
+
+static const char *_node_stats_packet_names[NODE_STATS_PACKET_COUNT] = {
+    [NODE_STATS_PACKET_TEMPERATURE] = "temperature",
+    [NODE_STATS_PACKET_HUMIDITY] = "humidity",
+    [NODE_STATS_PACKET_LUX_METER] = "lux-meter",
+    [NODE_STATS_PACKET_BAROMETER] = "barometer",
+    [NODE_STATS_PACKET_CO2] = "co2",
+    [NODE_STATS_PACKET_BATTERY] = "battery",
+    [NODE_STATS_PACKET_EVENT_COUNT] = "event-count",
+    [NODE_STATS_PACKET_STATE] = "state",
+    [NODE_STATS_PACKET_INFO] = "info",
+    [NODE_STATS_PACKET_VALUE] = "value",
+    [NODE_STATS_PACKET_BUFFER] = "buffer"
+};
+
+void node_stats_init(void)
+{
+    memset(_node_stats, 0, sizeof(_node_stats));
+    memset(_node_stats_total, 0, sizeof(_node_stats_total));
+}
+
+void node_stats_clear(int slot)
+{
+    if (slot == NODE_TABLE_SLOT_NONE)
+    {
+        return;
+    }
+
+    memset(&_node_stats[slot], 0, sizeof(_node_stats[slot]));
+}
+
+void node_stats_seen(int slot)
+{
+    if (slot == NODE_TABLE_SLOT_NONE)
+    {
+        return;
+    }
+
+    _node_stats[slot].last_seen = (uint32_t) bc_tick_get();
+    _node_stats[slot].seen = true;
+}
+
+void node_stats_packet(int slot, node_stats_packet_t type)
+{
+    _node_stats_total[type]++;
+
+    if (slot == NODE_TABLE_SLOT_NONE)
+    {
+        return;
+    }
+
+    node_stats_seen(slot);
+
+    _node_stats[slot].packets[type]++;
+}
+
+void node_stats_event_count(int slot, uint8_t event_id, uint16_t event_count)
+{
+    if ((slot == NODE_TABLE_SLOT_NONE) || (event_id >= NODE_STATS_EVENT_ID_COUNT))
+    {
+        return;
+    }
+
+    node_stats_t *stats = &_node_stats[slot];
+
+    if (stats->event_valid & (1 << event_id))
+    {
+        uint16_t gap = event_count - stats->event_count[event_id];
+
+        // A large or negative gap means the node was restarted, not that packets went missing
+        if ((gap > 1) && (gap <= NODE_STATS_EVENT_GAP_MAX))
+        {
+            stats->lost += gap - 1;
+        }
+    }
+
+    stats->event_count[event_id] = event_count;
+    stats->event_valid |= 1 << event_id;
+}
+
+uint32_t node_stats_get_total(node_stats_packet_t type)
+{
+    return _node_stats_total[type];
+}
+
+const char *node_stats_get_packet_name(node_stats_packet_t type)
+{
+    return _node_stats_packet_names[type];
+}
+
+void node_stats_publish(void)
+{
+    uint32_t now = (uint32_t) bc_tick_get();
+    const uint64_t *ids = node_table_get_ids();
+    int count = node_table_get_count();
+
+    usb_talk_message_start("/nodes/stats");
+
+    usb_talk_message_append("{\"fields\": [\"id\", \"age\", \"lost\"");
+
+    for (int i = 0; i < NODE_STATS_PACKET_COUNT; i++)
+    {
+        usb_talk_message_append(", \"%s\"", _node_stats_packet_names[i]);
+    }
+
+    usb_talk_message_append("], \"nodes\": [");
+
+    for (int i = 0; i < count; i++)
+    {
+        node_stats_t *stats = &_node_stats[node_table_get_slot(i)];
+
+        usb_talk_message_append(i == 0 ? "[\"" USB_TALK_DEVICE_ADDRESS "\"" : ", [\"" USB_TALK_DEVICE_ADDRESS "\"", ids[i]);
+
+        if (stats->seen)
+        {
+            usb_talk_message_append(", %" PRIu32, (now - stats->last_seen) / 1000);
+        }
+        else
+        {
+            usb_talk_message_append(", null");
+        }
+
+        usb_talk_message_append(", %" PRIu16, stats->lost);
+
+        for (int j = 0; j < NODE_STATS_PACKET_COUNT; j++)
+        {
+            usb_talk_message_append(",%" PRIu16, stats->packets[j]);
+        }
+
+        usb_talk_message_append("]");
+    }
+
+    usb_talk_message_append("]}");
+
+    usb_talk_message_send();
+}
@@ -0,0 +1,35 @@
+#ifndef _NODE_STATS_H
+#define _NODE_STATS_H
+
+#include <bc_common.h>
+
+#define NODE_STATS_EVENT_ID_COUNT 5
+#define NODE_STATS_EVENT_GAP_MAX 100
+
+typedef enum
+{
+    NODE_STATS_PACKET_TEMPERATURE = 0,
+    NODE_STATS_PACKET_HUMIDITY = 1,
+    NODE_STATS_PACKET_LUX_METER = 2,
+    NODE_STATS_PACKET_BAROMETER = 3,
+    NODE_STATS_PACKET_CO2 = 4,
+    NODE_STATS_PACKET_BATTERY = 5,
+    NODE_STATS_PACKET_EVENT_COUNT = 6,
+    NODE_STATS_PACKET_STATE = 7,
+    NODE_STATS_PACKET_INFO = 8,
+    NODE_STATS_PACKET_VALUE = 9,
+    NODE_STATS_PACKET_BUFFER = 10,
+    NODE_STATS_PACKET_COUNT = 11
+
+} node_stats_packet_t;
+
+void node_stats_init(void);
+void node_stats_clear(int slot);
+void node_stats_seen(int slot);
+void node_stats_packet(int slot, node_stats_packet_t type);
+void node_stats_event_count(int slot, uint8_t event_id, uint16_t event_count);
+uint32_t node_stats_get_total(node_stats_packet_t type);
+const char *node_stats_get_packet_name(node_stats_packet_t type);
+void node_stats_publish(void);
+
+#endif
@@ -0,0 +1,182 @@
+#include <node_table.h>
+#include <bcl.h>
+
+#define NODE_TABLE_SLOT_WORDS ((NODE_TABLE_SIZE + 31) / 32)
+
+// Peer ids are kept sorted so the per-packet lookup is a binary search,
+// every id owns a slot which stays the same for as long as the node is paired
+// and can be used to index per-node data elsewhere in the application.
+static struct
+{
+    uint64_t id[NODE_TABLE_SIZE];
+    uint8_t slot[NODE_TABLE_SIZE];
+    uint32_t slot_used[NODE_TABLE_SLOT_WORDS];
+    int count;
+
+} _node_table;
+
+static int _node_table_search(uint64_t id, bool *found);
+static int _node_table_slot_alloc(void);
+static void _node_table_slot_free(int slot);
+
+void node_table_init(void)
+{
+    memset(&_node_table, 0, sizeof(_node_table));
+}
+
+void node_table_reload(void)
+{
+    memset(&_node_table, 0, sizeof(_node_table));
+
+    // The radio fills the whole array, unused entries are zero
+    bc_radio_get_peer_id(_node_table.id, NODE_TABLE_SIZE);
+
+    for (int i = 0; i < NODE_TABLE_SIZE; i++)
+    {
+        uint64_t id = _node_table.id[i];
+
+        if (id == 0)
+        {
+            continue;
+        }
+
+        int j = _node_table.count;
+
+        while ((j > 0) && (_node_table.id[j - 1] > id))
+        {
+            _node_table.id[j] = _node_table.id[j - 1];
+            j--;
+        }
+
+        _node_table.id[j] = id;
+        _node_table.count++;
+    }
+
+    for (int i = 0; i < _node_table.count; i++)
+    {
+        _node_table.slot[i] = (uint8_t) _node_table_slot_alloc();
+    }
+}
+
+int node_table_add(uint64_t id)
+{
+    bool found;
+    int index = _node_table_search(id, &found);
+
+    if (found)
+    {
+        return _node_table.slot[index];
+    }
+
+    if (_node_table.count == NODE_TABLE_SIZE)
+    {
+        return NODE_TABLE_SLOT_NONE;
+    }
+
+    size_t tail = _node_table.count - index;
+
+    memmove(&_node_table.id[index + 1], &_node_table.id[index], tail * sizeof(_node_table.id[0]));
+    memmove(&_node_table.slot[index + 1], &_node_table.slot[index], tail * sizeof(_node_table.slot[0]));
+
+    int slot = _node_table_slot_alloc();
+
+    _node_table.id[index] = id;
+    _node_table.slot[index] = (uint8_t) slot;
+    _node_table.count++;
+
+    return slot;
+}
+
+bool node_table_remove(uint64_t id)
+{
+    bool found;
+    int index = _node_table_search(id, &found);
+
+    if (!found)
+    {
+        return false;
+    }
+
+    _node_table_slot_free(_node_table.slot[index]);
+
+    size_t tail = _node_table.count - index - 1;
+
+    memmove(&_node_table.id[index], &_node_table.id[index + 1], tail * sizeof(_node_table.id[0]));
+    memmove(&_node_table.slot[index], &_node_table.slot[index + 1], tail * sizeof(_node_table.slot[0]));
+
+    _node_table.count--;
+
+    return true;
+}
+
+void node_table_purge(void)
+{
+    memset(&_node_table, 0, sizeof(_node_table));
+}
+
+int node_table_find(uint64_t id)
+{
+    bool found;
+    int index = _node_table_search(id, &found);
+
+    return found ? _node_table.slot[index] : NODE_TABLE_SLOT_NONE;
+}
+
+int node_table_get_count(void)
+{
+    return _node_table.count;
+}
+
+int node_table_get_slot(int index)
+{
+    return _node_table.slot[index];
+}
+
+const uint64_t *node_table_get_ids(void)
+{
+    return _node_table.id;
+}
+
+static int _node_table_search(uint64_t id, bool *found)
+{
+    int low = 0;
+    int high = _node_table.count;
+
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+
+        if (_node_table.id[middle] < id)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    *found = (low < _node_table.count) && (_node_table.id[low] == id);
+
+    return low;
+}
+
+static int _node_table_slot_alloc(void)
+{
+    for (int i = 0; i < NODE_TABLE_SIZE; i++)
+    {
+        if ((_node_table.slot_used[i / 32] & (1UL << (i % 32))) == 0)
+        {
+            _node_table.slot_used[i / 32] |= 1UL << (i % 32);
+
+            return i;
+        }
+    }
+
+    return NODE_TABLE_SLOT_NONE;
+}
+
+static void _node_table_slot_free(int slot)
+{
+    _node_table.slot_used[slot / 32] &= ~(1UL << (slot % 32));
+}
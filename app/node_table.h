@@ -0,0 +1,20 @@
+#ifndef _NODE_TABLE_H
+#define _NODE_TABLE_H
+
+#include <bc_common.h>
+
+#define NODE_TABLE_SIZE BC_RADIO_MAX_DEVICES
+#define NODE_TABLE_PAGE_SIZE 16
+#define NODE_TABLE_SLOT_NONE (-1)
+
+void node_table_init(void);
+void node_table_reload(void);
+int node_table_add(uint64_t id);
+bool node_table_remove(uint64_t id);
+void node_table_purge(void);
+int node_table_find(uint64_t id);
+int node_table_get_count(void);
+int node_table_get_slot(int index);
+const uint64_t *node_table_get_ids(void);
+
+#endif
@@ -0,0 +1,408 @@
+#include <outbox.h>
+#include <node_table.h>
+#include <group.h>
+#include <radio.h>
+#include <usb_talk.h>
+#include <trace.h>
+#include <bcl.h>
+
+#define OUTBOX_STATE_LENGTH 2
+
+_Static_assert(GROUP_MEMBER_COUNT <= 24, "RADIO_GROUP_STATE_SET carries a 3 byte member bitmap");
+
+typedef struct
+{
+    uint64_t id;
+    bc_tick_t expiration;
+    uint32_t target;
+    uint8_t length;
+    uint8_t buffer[OUTBOX_BUFFER_SIZE];
+
+} outbox_entry_t;
+
+// Sleeping nodes only listen for a moment after they transmit, so every command
+// is sent right away and a copy is kept until the node acknowledges it or is heard from.
+// Entries are kept in the order they were queued and are released in that order.
+// A node that answers the first transmission, with an acknowledge or any other packet,
+// does not sleep, it gets no copies.
+static struct
+{
+    outbox_entry_t entry[OUTBOX_SIZE];
+    int count;
+    bool listening[NODE_TABLE_SIZE];
+
+    // Collects the listening members while usb_talk expands a group command
+    struct
+    {
+        bool active;
+        uint8_t group;
+        uint8_t member;
+        uint32_t bitmap;
+        uint8_t state_id;
+        bool state;
+
+    } group;
+
+    uint32_t queued;
+    uint32_t replaced;
+    uint32_t released;
+    uint32_t acknowledged;
+    uint32_t expired;
+    uint32_t dropped;
+    uint32_t broadcast;
+
+} _outbox;
+
+static bool _outbox_add(uint64_t *id, uint32_t target, const void *buffer, size_t length);
+static bool _outbox_listening(uint64_t *id);
+static bool _outbox_answered(outbox_entry_t *entry);
+static void _outbox_listen(uint64_t *id);
+static bool _outbox_group_collect(uint64_t *id, uint8_t state_id, bool state);
+static void _outbox_delete(int index);
+static void _outbox_expire(void);
+static bool _outbox_send(outbox_entry_t *entry);
+
+void outbox_init(void)
+{
+    memset(&_outbox, 0, sizeof(_outbox));
+}
+
+bool outbox_state_set(uint64_t *id, uint8_t state_id, bool *state)
+{
+    uint8_t buffer[OUTBOX_STATE_LENGTH] = { state_id, *state };
+
+    if (_outbox_group_collect(id, state_id, *state))
+    {
+        outbox_remove(id, OUTBOX_TARGET_STATE(state_id), OUTBOX_TARGET_ALL);
+
+        return true;
+    }
+
+    return _outbox_add(id, OUTBOX_TARGET_STATE(state_id), buffer, sizeof(buffer));
+}
+
+bool outbox_buffer(uint64_t *id, uint32_t target, const void *buffer, size_t length)
+{
+    if (length > OUTBOX_BUFFER_SIZE)
+    {
+        // Too large to keep, an older copy for the same target must not arrive after it
+        outbox_remove(id, target, OUTBOX_TARGET_ALL);
+
+        return bc_radio_pub_buffer((void *) buffer, length);
+    }
+
+    return _outbox_add(id, target, buffer, length);
+}
+
+void outbox_remove(uint64_t *id, uint32_t target, uint32_t mask)
+{
+    for (int i = _outbox.count - 1; i >= 0; i--)
+    {
+        if ((_outbox.entry[i].id == *id) && ((_outbox.entry[i].target & mask) == (target & mask)))
+        {
+            _outbox_delete(i);
+        }
+    }
+}
+
+void outbox_state_ack(uint64_t *id, uint8_t state_id, bool *state)
+{
+    if (state == NULL)
+    {
+        return;
+    }
+
+    for (int i = 0; i < _outbox.count; i++)
+    {
+        outbox_entry_t *entry = &_outbox.entry[i];
+
+        if ((entry->id == *id) && (entry->target == OUTBOX_TARGET_STATE(state_id)) && (entry->buffer[1] == *state))
+        {
+            if (_outbox_answered(entry))
+            {
+                _outbox_listen(id);
+            }
+
+            _outbox_delete(i);
+
+            _outbox.acknowledged++;
+
+            return;
+        }
+    }
+}
+
+void outbox_group_begin(int group)
+{
+    memset(&_outbox.group, 0, sizeof(_outbox.group));
+
+    _outbox.group.active = true;
+    _outbox.group.group = (uint8_t) group;
+}
+
+void outbox_group_member(int member)
+{
+    _outbox.group.member = (uint8_t) member;
+}
+
+uint32_t outbox_group_end(void)
+{
+    _outbox.group.active = false;
+
+    if (_outbox.group.bitmap == 0)
+    {
+        return 0;
+    }
+
+    uint8_t buffer[] = {
+        RADIO_GROUP_STATE_SET, _outbox.group.group,
+        _outbox.group.bitmap & 0xff, (_outbox.group.bitmap >> 8) & 0xff, (_outbox.group.bitmap >> 16) & 0xff,
+        _outbox.group.state_id, _outbox.group.state
+    };
+
+    if (!bc_radio_pub_buffer(buffer, sizeof(buffer)))
+    {
+        return _outbox.group.bitmap;
+    }
+
+    _outbox.broadcast++;
+
+    return 0;
+}
+
+void outbox_forget(uint64_t *id)
+{
+    int slot = node_table_find(*id);
+
+    if (slot != NODE_TABLE_SLOT_NONE)
+    {
+        _outbox.listening[slot] = false;
+    }
+
+    outbox_remove(id, 0, 0);
+}
+
+void outbox_node_seen(uint64_t *id)
+{
+    _outbox_expire();
+
+    // Nodes that only get buffers never acknowledge, hearing from them right after a send is the answer
+    for (int i = 0; i < _outbox.count; i++)
+    {
+        if ((_outbox.entry[i].id == *id) && _outbox_answered(&_outbox.entry[i]))
+        {
+            _outbox_listen(id);
+
+            break;
+        }
+    }
+
+    int i = 0;
+
+    while (i < _outbox.count)
+    {
+        if (_outbox.entry[i].id != *id)
+        {
+            i++;
+
+            continue;
+        }
+
+        // Radio TX queue is full, keep the rest for the next time the node shows up
+        if (!_outbox_send(&_outbox.entry[i]))
+        {
+            break;
+        }
+
+        trace_outbox(_outbox.entry[i].expiration - OUTBOX_EXPIRATION);
+
+        _outbox_delete(i);
+
+        _outbox.released++;
+    }
+}
+
+int outbox_get_pending(void)
+{
+    _outbox_expire();
+
+    return _outbox.count;
+}
+
+void outbox_publish(void)
+{
+    _outbox_expire();
+
+    usb_talk_message_start("/outbox");
+
+    usb_talk_message_append("{\"pending\": %d, \"capacity\": %d, \"queued\": %" PRIu32 ", \"replaced\": %" PRIu32
+                            ", \"released\": %" PRIu32 ", \"acknowledged\": %" PRIu32 ", \"expired\": %" PRIu32 ", \"dropped\": %" PRIu32 ", \"broadcast\": %" PRIu32 ", \"nodes\": {",
+                            _outbox.count, OUTBOX_SIZE, _outbox.queued, _outbox.replaced,
+                            _outbox.released, _outbox.acknowledged, _outbox.expired, _outbox.dropped, _outbox.broadcast);
+
+    bool empty = true;
+
+    for (int i = 0; i < _outbox.count; i++)
+    {
+        int depth = 0;
+        bool first = true;
+
+        for (int j = 0; j < _outbox.count; j++)
+        {
+            if (_outbox.entry[j].id == _outbox.entry[i].id)
+            {
+                if (j < i)
+                {
+                    first = false;
+
+                    break;
+                }
+
+                depth++;
+            }
+        }
+
+        if (!first)
+        {
+            continue;
+        }
+
+        usb_talk_message_append(empty ? "\"" USB_TALK_DEVICE_ADDRESS "\": %d" : ", \"" USB_TALK_DEVICE_ADDRESS "\": %d", _outbox.entry[i].id, depth);
+
+        empty = false;
+    }
+
+    usb_talk_message_append("}}");
+
+    usb_talk_message_send();
+}
+
+static bool _outbox_add(uint64_t *id, uint32_t target, const void *buffer, size_t length)
+{
+    _outbox_expire();
+
+    // Latest wins, the older command for the same target is dropped and the new one goes to the end
+    for (int i = 0; i < _outbox.count; i++)
+    {
+        if ((_outbox.entry[i].id == *id) && (_outbox.entry[i].target == target))
+        {
+            _outbox_delete(i);
+
+            _outbox.replaced++;
+
+            break;
+        }
+    }
+
+    if (_outbox_listening(id))
+    {
+        outbox_entry_t entry = { .id = *id, .target = target, .length = (uint8_t) length };
+
+        memcpy(entry.buffer, buffer, length);
+
+        // Queued like for a sleeping node only when the radio TX queue is full
+        if (_outbox_send(&entry))
+        {
+            return true;
+        }
+    }
+
+    if (_outbox.count == OUTBOX_SIZE)
+    {
+        _outbox_delete(0);
+
+        _outbox.dropped++;
+    }
+
+    outbox_entry_t *entry = &_outbox.entry[_outbox.count++];
+
+    entry->id = *id;
+    entry->target = target;
+    entry->expiration = bc_tick_get() + OUTBOX_EXPIRATION;
+    entry->length = (uint8_t) length;
+    memcpy(entry->buffer, buffer, length);
+
+    _outbox.queued++;
+
+    return _outbox_send(entry);
+}
+
+static bool _outbox_listening(uint64_t *id)
+{
+    int slot = node_table_find(*id);
+
+    return (slot != NODE_TABLE_SLOT_NONE) && _outbox.listening[slot];
+}
+
+// Heard within the window after the transmission made when the entry was queued, not one released later
+static bool _outbox_answered(outbox_entry_t *entry)
+{
+    return bc_tick_get() <= entry->expiration - OUTBOX_EXPIRATION + OUTBOX_LISTEN_WINDOW;
+}
+
+static void _outbox_listen(uint64_t *id)
+{
+    int slot = node_table_find(*id);
+
+    if (slot != NODE_TABLE_SLOT_NONE)
+    {
+        _outbox.listening[slot] = true;
+    }
+}
+
+// Members that already share the first collected state ride on the broadcast, everything else is sent per node
+static bool _outbox_group_collect(uint64_t *id, uint8_t state_id, bool state)
+{
+    if (!GROUP_BROADCAST || !_outbox.group.active || !_outbox_listening(id))
+    {
+        return false;
+    }
+
+    if (_outbox.group.bitmap == 0)
+    {
+        _outbox.group.state_id = state_id;
+        _outbox.group.state = state;
+    }
+    else if ((_outbox.group.state_id != state_id) || (_outbox.group.state != state))
+    {
+        return false;
+    }
+
+    _outbox.group.bitmap |= (uint32_t) 1 << _outbox.group.member;
+
+    return true;
+}
+
+static void _outbox_delete(int index)
+{
+    _outbox.count--;
+
+    memmove(&_outbox.entry[index], &_outbox.entry[index + 1], (_outbox.count - index) * sizeof(_outbox.entry[0]));
+}
+
+static void _outbox_expire(void)
+{
+    bc_tick_t now = bc_tick_get();
+
+    for (int i = _outbox.count - 1; i >= 0; i--)
+    {
+        if (_outbox.entry[i].expiration < now)
+        {
+            _outbox_delete(i);
+
+            _outbox.expired++;
+        }
+    }
+}
+
+static bool _outbox_send(outbox_entry_t *entry)
+{
+    if ((entry->target & OUTBOX_TARGET_HEADER_MASK) == 0)
+    {
+        bool state = entry->buffer[1];
+
+        return bc_radio_node_state_set(&entry->id, entry->buffer[0], &state);
+    }
+
+    return bc_radio_pub_buffer(entry->buffer, entry->length);
+}
@@ -0,0 +1,36 @@
+#ifndef _OUTBOX_H
+#define _OUTBOX_H
+
+#include <bc_common.h>
+
+#define OUTBOX_SIZE 16
+#define OUTBOX_BUFFER_SIZE 48
+#define OUTBOX_EXPIRATION (10 * 60 * 1000)
+#define OUTBOX_LISTEN_WINDOW 1000
+
+// Commands are replaced per (node, target), state commands use the state id as target,
+// buffers use their radio header in the upper half and a caller chosen index in the lower half
+#define OUTBOX_TARGET_STATE(state_id) ((uint32_t) (state_id))
+#define OUTBOX_TARGET_BUFFER(header, index) ((((uint32_t) (header)) << 16) | ((index) & 0xffff))
+#define OUTBOX_TARGET_HEADER_MASK 0xffff0000
+#define OUTBOX_TARGET_ALL 0xffffffff
+
+void outbox_init(void);
+bool outbox_state_set(uint64_t *id, uint8_t state_id, bool *state);
+bool outbox_buffer(uint64_t *id, uint32_t target, const void *buffer, size_t length);
+void outbox_remove(uint64_t *id, uint32_t target, uint32_t mask);
+void outbox_state_ack(uint64_t *id, uint8_t state_id, bool *state);
+
+// While a group command is expanded, state commands for members known to listen are collected
+// into one RADIO_GROUP_STATE_SET, end sends it and returns the members it could not reach
+void outbox_group_begin(int group);
+void outbox_group_member(int member);
+uint32_t outbox_group_end(void);
+
+// Drops everything queued for the node and what was learned about it, call before it leaves the node table
+void outbox_forget(uint64_t *id);
+void outbox_node_seen(uint64_t *id);
+int outbox_get_pending(void);
+void outbox_publish(void);
+
+#endif
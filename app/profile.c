@@ -0,0 +1,155 @@
+#include <profile.h>
+#include <usb_talk.h>
+#include <bcl.h>
+
+// The microsecond timer wraps after 65 ms, longer runs fall back to the tick
+#define PROFILE_TIMER_RANGE 50
+
+#if PROFILE
+
+typedef struct
+{
+    void (*task)(void *);
+    void *param;
+    const char *name;
+    bc_scheduler_task_id_t id;
+    bool timer;
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+
+} profile_task_t;
+
+// Profiled tasks are registered with a trampoline that gets their table entry as the parameter,
+// the scheduler keeps the task id, so plan_current_* calls inside the task work as before
+static struct
+{
+    profile_task_t task[PROFILE_TASK_COUNT];
+    int count;
+    int untracked;
+    bc_tick_t since;
+
+} _profile;
+
+static void _profile_trampoline(void *param);
+
+void profile_init(void)
+{
+    memset(&_profile, 0, sizeof(_profile));
+
+    bc_timer_init();
+}
+
+bc_scheduler_task_id_t profile_register(void (*task)(void *), void *param, bc_tick_t tick, const char *name, bool timer)
+{
+    if (_profile.count == PROFILE_TASK_COUNT)
+    {
+        _profile.untracked++;
+
+        return bc_scheduler_register(task, param, tick);
+    }
+
+    profile_task_t *entry = &_profile.task[_profile.count++];
+
+    entry->task = task;
+    entry->param = param;
+    entry->name = name;
+    entry->timer = timer;
+    entry->id = bc_scheduler_register(_profile_trampoline, entry, tick);
+
+    return entry->id;
+}
+
+void profile_reset(void)
+{
+    for (int i = 0; i < _profile.count; i++)
+    {
+        _profile.task[i].count = 0;
+        _profile.task[i].max = 0;
+        _profile.task[i].total = 0;
+    }
+
+    _profile.since = bc_tick_get();
+}
+
+void profile_publish(void)
+{
+    usb_talk_message_start("/profile");
+
+    usb_talk_message_append("{\"period-ms\": %lu, \"untracked\": %d, \"tasks\": [",
+            (unsigned long) (bc_tick_get() - _profile.since), _profile.untracked);
+
+    for (int i = 0; i < _profile.count; i++)
+    {
+        profile_task_t *entry = &_profile.task[i];
+
+        usb_talk_message_append("%s{\"task\": \"%s\", \"id\": %d, \"count\": %lu, \"total-ms\": %lu, \"max-us\": %lu, \"mean-us\": %lu, \"resolution-us\": %d}",
+                i == 0 ? "" : ", ", entry->name, (int) entry->id, (unsigned long) entry->count, (unsigned long) (entry->total / 1000),
+                (unsigned long) entry->max, (unsigned long) (entry->count == 0 ? 0 : entry->total / entry->count), entry->timer ? 1 : 1000);
+    }
+
+    usb_talk_message_append("]}");
+
+    usb_talk_message_send();
+}
+
+static void _profile_trampoline(void *param)
+{
+    profile_task_t *entry = param;
+    bc_tick_t tick = bc_tick_get();
+    uint32_t elapsed = 0;
+
+    if (entry->timer)
+    {
+        bc_timer_start();
+    }
+
+    entry->task(entry->param);
+
+    if (entry->timer)
+    {
+        elapsed = bc_timer_get_microseconds();
+
+        bc_timer_stop();
+    }
+
+    tick = bc_tick_get() - tick;
+
+    if (!entry->timer || (tick > PROFILE_TIMER_RANGE))
+    {
+        elapsed = tick * 1000;
+    }
+
+    entry->count++;
+    entry->total += elapsed;
+
+    if (elapsed > entry->max)
+    {
+        entry->max = elapsed;
+    }
+}
+
+#else
+
+void profile_init(void)
+{
+}
+
+bc_scheduler_task_id_t profile_register(void (*task)(void *), void *param, bc_tick_t tick, const char *name, bool timer)
+{
+    (void) name;
+    (void) timer;
+
+    return bc_scheduler_register(task, param, tick);
+}
+
+void profile_reset(void)
+{
+}
+
+void profile_publish(void)
+{
+    usb_talk_send_string("[\"/profile\", null]\n");
+}
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef _PROFILE_H
+#define _PROFILE_H
+
+#include <bc_common.h>
+#include <bc_scheduler.h>
+
+// Build with PROFILE=1 to time every task registered through PROFILE_REGISTER
+#ifndef PROFILE
+#define PROFILE 0
+#endif
+
+#define PROFILE_TASK_COUNT 16
+
+// Tasks that use bc_timer themselves, I2C transfers do, would stop the timer under the measurement,
+// they are registered with PROFILE_REGISTER_TICK and timed by the tick only
+#if PROFILE
+#define PROFILE_REGISTER(task, param, tick) profile_register((task), (param), (tick), #task, true)
+#define PROFILE_REGISTER_TICK(task, param, tick) profile_register((task), (param), (tick), #task, false)
+#else
+#define PROFILE_REGISTER(task, param, tick) bc_scheduler_register((task), (param), (tick))
+#define PROFILE_REGISTER_TICK(task, param, tick) bc_scheduler_register((task), (param), (tick))
+#endif
+
+void profile_init(void);
+
+bc_scheduler_task_id_t profile_register(void (*task)(void *), void *param, bc_tick_t tick, const char *name, bool timer);
+
+void profile_reset(void);
+
+void profile_publish(void);
+
+#endif
@@ -5,6 +5,17 @@
 
 #define RADIO_LCD_TEXT_SET          0x22
 #define RADIO_LCD_SCREEN_CLEAR      0x23
+// HEAD + ADDRESS + n * (X + Y + FONT_SIZE | COLOR << 7 + LENGTH + TEXT)
+#define RADIO_LCD_TEXTS_SET         0x24
+
+// HEAD + ADDRESS + PACKED COMPOUND, see compound.h
+#define RADIO_LED_STRIP_COMPOUND_PACKED_SET 0x25
+
+// HEAD + ADDRESS + GROUP + MEMBER, tells a node which bit is its own in the group,
+// MEMBER is GROUP_MEMBER_NONE when it left, ADDRESS 0 with GROUP_MEMBER_NONE when the group was deleted
+#define RADIO_GROUP_JOIN            0x26
+// HEAD + GROUP + MEMBER BITMAP (3 bytes, little endian) + STATE_ID + STATE, one packet for all members
+#define RADIO_GROUP_STATE_SET       0x27
 
 #define RADIO_RELAY_0_PULSE_SET   0x32
 #define RADIO_RELAY_1_PULSE_SET   0x33
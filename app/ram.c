@@ -0,0 +1,76 @@
+#include <ram.h>
+#include <usb_talk.h>
+
+// RAM per module from the linker map of the previous link, see tools/ram_map.awk,
+// a build without that step only reports the totals
+#if __has_include(<ram_map.h>)
+#include <ram_map.h>
+#else
+#define RAM_MAP
+#endif
+
+// Provided by the linker script
+extern uint32_t _sdata;
+extern uint32_t _edata;
+extern uint32_t _sbss;
+extern uint32_t _ebss;
+extern uint32_t _estack;
+
+typedef struct
+{
+    const char *name;
+    size_t size;
+
+} ram_module_t;
+
+static const ram_module_t _ram_module[] = { RAM_MAP { NULL, 0 } };
+
+// Everything between the heap reserve above .bss and the current stack pointer is painted once,
+// the lowest word that lost the pattern marks the deepest the stack has ever been
+static uint32_t *_ram_paint_start;
+
+void ram_init(void)
+{
+    uint32_t marker;
+    uint32_t *end = (uint32_t *) ((uintptr_t) &marker - RAM_STACK_GUARD);
+
+    _ram_paint_start = (uint32_t *) ((uintptr_t) &_ebss + RAM_HEAP_RESERVE);
+
+    for (uint32_t *word = _ram_paint_start; word < end; word++)
+    {
+        *word = RAM_STACK_PATTERN;
+    }
+}
+
+size_t ram_get_stack_used(void)
+{
+    uint32_t *word = _ram_paint_start;
+
+    while ((word < &_estack) && (*word == RAM_STACK_PATTERN))
+    {
+        word++;
+    }
+
+    return (uintptr_t) &_estack - (uintptr_t) word;
+}
+
+void ram_publish(void)
+{
+    size_t stack_size = (uintptr_t) &_estack - (uintptr_t) _ram_paint_start;
+    size_t stack_used = ram_get_stack_used();
+
+    usb_talk_message_start("/memory");
+
+    usb_talk_message_append("{\"data\": %u, \"bss\": %u, \"stack\": {\"size\": %u, \"used\": %u, \"free\": %u}, \"modules\": {",
+            (unsigned) ((uintptr_t) &_edata - (uintptr_t) &_sdata), (unsigned) ((uintptr_t) &_ebss - (uintptr_t) &_sbss),
+            (unsigned) stack_size, (unsigned) stack_used, (unsigned) (stack_size - stack_used));
+
+    for (size_t i = 0; _ram_module[i].name != NULL; i++)
+    {
+        usb_talk_message_append("%s\"%s\": %u", i == 0 ? "" : ", ", _ram_module[i].name, (unsigned) _ram_module[i].size);
+    }
+
+    usb_talk_message_append("}}");
+
+    usb_talk_message_send();
+}
@@ -0,0 +1,18 @@
+#ifndef _RAM_H
+#define _RAM_H
+
+#include <bc_common.h>
+
+#define RAM_STACK_PATTERN 0xa5a5a5a5
+#define RAM_STACK_GUARD 64
+#define RAM_HEAP_RESERVE 512
+
+// Paints the unused stack, call first thing in application_init
+void ram_init(void);
+
+// Deepest stack use seen since boot in bytes
+size_t ram_get_stack_used(void);
+
+void ram_publish(void);
+
+#endif
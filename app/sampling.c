@@ -0,0 +1,26 @@
+#include <sampling.h>
+
+bc_tick_t sampling_next_interval(bc_tick_t interval, int32_t change, const config_sensor_t *config)
+{
+    bc_tick_t interval_min = (bc_tick_t) config->interval_min * 1000;
+    bc_tick_t interval_max = (bc_tick_t) config->interval_max * 1000;
+
+    // Sampling speeds up to the minimum interval once a value moves by half of its publish threshold
+    // and slows down towards the maximum while it stays within an eighth of it
+    if (change >= (config->value_change / 2))
+    {
+        return interval_min;
+    }
+
+    if (change < (config->value_change / 8))
+    {
+        interval += interval / 2;
+    }
+
+    if (interval < interval_min)
+    {
+        return interval_min;
+    }
+
+    return interval > interval_max ? interval_max : interval;
+}
@@ -0,0 +1,10 @@
+#ifndef _SAMPLING_H
+#define _SAMPLING_H
+
+#include <config.h>
+
+// Interval for the next sample of a tag after a sample that moved by change raw units from the one before,
+// no SDK calls so the host simulation in host/test/sampling.c runs the same rule
+bc_tick_t sampling_next_interval(bc_tick_t interval, int32_t change, const config_sensor_t *config);
+
+#endif
@@ -1,92 +1,622 @@
 #include <sensors.h>
 #include <usb_talk.h>
+#include <stream.h>
+#include <config.h>
+#include <sampling.h>
+#include <timestamp.h>
+#include <profile.h>
 #include <bc_radio_pub.h>
 
+typedef struct
+{
+    union
+    {
+        temperature_tag_t temperature;
+        humidity_tag_t humidity;
+        lux_meter_tag_t lux_meter;
+        barometer_tag_t barometer;
+
+    } tag;
+
+    bool present;
+    bool pending;
+    bc_tick_t interval;
+    bc_tick_t due;
+    bc_tick_t started;
+    value_t last;
+    bool sampled;
+
+} sensor_t;
+
+typedef struct
+{
+    int active;
+    bc_tick_t hold_until;
+    bc_tick_t occupied;
+    bc_tick_t window_start;
+    bc_tick_t wait_max;
+    uint32_t measurements;
+    uint32_t errors;
+
+} sensors_bus_t;
+
+// Every tag or module the gateway knows how to read, with the register used to detect it.
+// Variant is the tag I2C address enum or the humidity tag revision.
+static const sensor_descriptor_t _sensors_descriptor[] = {
+    { SENSOR_TYPE_TEMPERATURE, BC_I2C_I2C0, 0x48, BC_TAG_TEMPERATURE_I2C_ADDRESS_DEFAULT, 0x01, 0x00, 0x00 },
+    { SENSOR_TYPE_TEMPERATURE, BC_I2C_I2C0, 0x49, BC_TAG_TEMPERATURE_I2C_ADDRESS_ALTERNATE, 0x01, 0x00, 0x00 },
+    { SENSOR_TYPE_TEMPERATURE, BC_I2C_I2C1, 0x48, BC_TAG_TEMPERATURE_I2C_ADDRESS_DEFAULT, 0x01, 0x00, 0x00 },
+    { SENSOR_TYPE_TEMPERATURE, BC_I2C_I2C1, 0x49, BC_TAG_TEMPERATURE_I2C_ADDRESS_ALTERNATE, 0x01, 0x00, 0x00 },
+    { SENSOR_TYPE_HUMIDITY, BC_I2C_I2C0, 0x5f, BC_TAG_HUMIDITY_REVISION_R1, 0x0f, 0xff, 0xbc },
+    { SENSOR_TYPE_HUMIDITY, BC_I2C_I2C0, 0x40, BC_TAG_HUMIDITY_REVISION_R2, 0xff, 0xff, 0x07 },
+    { SENSOR_TYPE_HUMIDITY, BC_I2C_I2C0, 0x40, BC_TAG_HUMIDITY_REVISION_R3, 0xe7, 0x02, 0x02 },
+    { SENSOR_TYPE_HUMIDITY, BC_I2C_I2C1, 0x5f, BC_TAG_HUMIDITY_REVISION_R1, 0x0f, 0xff, 0xbc },
+    { SENSOR_TYPE_HUMIDITY, BC_I2C_I2C1, 0x40, BC_TAG_HUMIDITY_REVISION_R2, 0xff, 0xff, 0x07 },
+    { SENSOR_TYPE_HUMIDITY, BC_I2C_I2C1, 0x40, BC_TAG_HUMIDITY_REVISION_R3, 0xe7, 0x02, 0x02 },
+    { SENSOR_TYPE_LUX_METER, BC_I2C_I2C0, 0x44, BC_TAG_LUX_METER_I2C_ADDRESS_DEFAULT, 0x7e, 0xff, 0x54 },
+    { SENSOR_TYPE_LUX_METER, BC_I2C_I2C0, 0x45, BC_TAG_LUX_METER_I2C_ADDRESS_ALTERNATE, 0x7e, 0xff, 0x54 },
+    { SENSOR_TYPE_LUX_METER, BC_I2C_I2C1, 0x44, BC_TAG_LUX_METER_I2C_ADDRESS_DEFAULT, 0x7e, 0xff, 0x54 },
+    { SENSOR_TYPE_LUX_METER, BC_I2C_I2C1, 0x45, BC_TAG_LUX_METER_I2C_ADDRESS_ALTERNATE, 0x7e, 0xff, 0x54 },
+    { SENSOR_TYPE_BAROMETER, BC_I2C_I2C0, 0x60, 0, 0x0c, 0xff, 0xc4 },
+    { SENSOR_TYPE_BAROMETER, BC_I2C_I2C1, 0x60, 0, 0x0c, 0xff, 0xc4 },
+    { SENSOR_TYPE_CO2, BC_I2C_I2C0, 0x38, 0, 0x00, 0x00, 0x00 }
+};
+
+#define SENSORS_COUNT (sizeof(_sensors_descriptor) / sizeof(_sensors_descriptor[0]))
+#define SENSORS_NONE (-1)
+
 static uint64_t *_device_address;
 
+static sensor_t _sensors[SENSORS_COUNT];
+
+static sensors_bus_t _sensors_bus[SENSORS_BUS_COUNT];
+
+static bc_scheduler_task_id_t _sensors_bus_task_id;
+
+static bool _sensors_probe(void);
+static void _sensors_rescan_task(void *param);
+static void _sensors_bus_task(void *param);
+static event_param_t *_sensors_param(size_t index);
+static void _sensors_measure_done(uint8_t index, bool error);
+static void _sensors_adapt(uint8_t index, const value_t *value);
+static const config_sensor_t *_sensors_config(size_t index);
+
 void sensors_init_all(uint64_t *my_device_address)
 {
-	_device_address = my_device_address;
+    _device_address = my_device_address;
+
+    memset(_sensors, 0, sizeof(_sensors));
+
+    for (int bus = 0; bus < SENSORS_BUS_COUNT; bus++)
+    {
+        memset(&_sensors_bus[bus], 0, sizeof(_sensors_bus[bus]));
+
+        _sensors_bus[bus].active = SENSORS_NONE;
+    }
+
+    _sensors_bus_task_id = PROFILE_REGISTER_TICK(_sensors_bus_task, NULL, BC_TICK_INFINITY);
+
+    bc_i2c_init(BC_I2C_I2C0, BC_I2C_SPEED_400_KHZ);
+    bc_i2c_init(BC_I2C_I2C1, BC_I2C_SPEED_400_KHZ);
+
+    _sensors_probe();
+
+    pir_module_init();
+
+    PROFILE_REGISTER_TICK(_sensors_rescan_task, NULL, SENSORS_RESCAN_INTERVAL);
+}
+
+const char *sensors_get_type_name(sensor_type_t type)
+{
+    static const char *names[SENSOR_TYPE_COUNT] = {
+        [SENSOR_TYPE_TEMPERATURE] = "thermometer",
+        [SENSOR_TYPE_HUMIDITY] = "hygrometer",
+        [SENSOR_TYPE_LUX_METER] = "lux-meter",
+        [SENSOR_TYPE_BAROMETER] = "barometer",
+        [SENSOR_TYPE_CO2] = "co2-meter"
+    };
+
+    return type < SENSOR_TYPE_COUNT ? names[type] : "-";
+}
+
+void sensors_publish_inventory(void)
+{
+    bool empty = true;
+
+    usb_talk_message_start("/sensors");
+
+    usb_talk_message_append("[");
+
+    for (size_t i = 0; i < SENSORS_COUNT; i++)
+    {
+        if (!_sensors[i].present)
+        {
+            continue;
+        }
+
+        const sensor_descriptor_t *descriptor = &_sensors_descriptor[i];
+
+        usb_talk_message_append(empty ? "\"%s/" : ", \"%s/", sensors_get_type_name(descriptor->type));
+
+        if (descriptor->type == SENSOR_TYPE_CO2)
+        {
+            usb_talk_message_append("-\"");
+        }
+        else
+        {
+            uint8_t channel = _sensors_param(i)->channel;
+
+            usb_talk_message_append("%d:%d\"", ((channel & 0x80) >> 7), (channel & ~0x80));
+        }
+
+        empty = false;
+    }
+
+    usb_talk_message_append("]");
+
+    usb_talk_message_send();
+}
+
+void sensors_publish_bus(void)
+{
+    bc_tick_t now = bc_scheduler_get_spin_tick();
+
+    usb_talk_message_start("/sensors/bus");
+
+    usb_talk_message_append("[");
+
+    for (int bus = 0; bus < SENSORS_BUS_COUNT; bus++)
+    {
+        sensors_bus_t *self = &_sensors_bus[bus];
+        bc_tick_t elapsed = now - self->window_start;
+        int count = 0;
+
+        for (size_t i = 0; i < SENSORS_COUNT; i++)
+        {
+            if (_sensors[i].present && (_sensors[i].interval != 0) && (_sensors_descriptor[i].i2c_channel == (bc_i2c_channel_t) bus))
+            {
+                count++;
+            }
+        }
+
+        usb_talk_message_append(bus == 0 ? "{" : ", {");
+        usb_talk_message_append("\"bus\": %d, \"sensors\": %d, ", bus, count);
+        usb_talk_message_append("\"measurements\": %lu, \"errors\": %lu, ", (unsigned long) self->measurements, (unsigned long) self->errors);
+        usb_talk_message_append("\"utilization-permille\": %lu, ", elapsed == 0 ? 0UL : (unsigned long) ((1000 * self->occupied) / elapsed));
+        usb_talk_message_append("\"wait-max\": %lu}", (unsigned long) self->wait_max);
+
+        // Every report starts a new window
+        self->window_start = now;
+        self->occupied = 0;
+        self->wait_max = 0;
+        self->measurements = 0;
+        self->errors = 0;
+    }
+
+    usb_talk_message_append("]");
+
+    usb_talk_message_send();
+}
+
+static event_param_t *_sensors_param(size_t index)
+{
+    sensor_t *sensor = &_sensors[index];
+
+    switch (_sensors_descriptor[index].type)
+    {
+        case SENSOR_TYPE_TEMPERATURE:
+        {
+            return &sensor->tag.temperature.param;
+        }
+        case SENSOR_TYPE_HUMIDITY:
+        {
+            return &sensor->tag.humidity.param;
+        }
+        case SENSOR_TYPE_LUX_METER:
+        {
+            return &sensor->tag.lux_meter.param;
+        }
+        case SENSOR_TYPE_BAROMETER:
+        {
+            return &sensor->tag.barometer.param;
+        }
+        default:
+        {
+            return NULL;
+        }
+    }
+}
+
+static bool _sensors_measure(size_t index)
+{
+    sensor_t *sensor = &_sensors[index];
+
+    switch (_sensors_descriptor[index].type)
+    {
+        case SENSOR_TYPE_TEMPERATURE:
+        {
+            return bc_tag_temperature_measure(&sensor->tag.temperature.self);
+        }
+        case SENSOR_TYPE_HUMIDITY:
+        {
+            return bc_tag_humidity_measure(&sensor->tag.humidity.self);
+        }
+        case SENSOR_TYPE_LUX_METER:
+        {
+            return bc_tag_lux_meter_measure(&sensor->tag.lux_meter.self);
+        }
+        case SENSOR_TYPE_BAROMETER:
+        {
+            return bc_tag_barometer_measure(&sensor->tag.barometer.self);
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+static void _sensors_schedule(size_t index)
+{
+    const sensor_descriptor_t *descriptor = &_sensors_descriptor[index];
+    sensor_t *sensor = &_sensors[index];
+    int bus = descriptor->i2c_channel;
+    int slot = 0;
+
+    // CO2 module runs its own UART bridge sequence and keeps its own interval
+    if (descriptor->type == SENSOR_TYPE_CO2)
+    {
+        return;
+    }
+
+    sensor->interval = (bc_tick_t) _sensors_config(index)->interval_min * 1000;
+
+    for (size_t i = 0; i < SENSORS_COUNT; i++)
+    {
+        if ((i != index) && _sensors[i].present && (_sensors[i].interval != 0) && (_sensors_descriptor[i].i2c_channel == descriptor->i2c_channel))
+        {
+            slot++;
+        }
+    }
+
+    // Tags on one bus take consecutive slots, the second bus is shifted by half a slot
+    sensor->due = bc_scheduler_get_spin_tick() + (slot * SENSORS_BUS_SLOT) + (bus * (SENSORS_BUS_SLOT / 2));
+
+    bc_scheduler_plan_now(_sensors_bus_task_id);
+}
+
+static bool _sensors_probe(void)
+{
+    bool found = false;
+
+    for (size_t i = 0; i < SENSORS_COUNT; i++)
+    {
+        const sensor_descriptor_t *descriptor = &_sensors_descriptor[i];
+        sensor_t *sensor = &_sensors[i];
+        uint8_t value;
+
+        if (sensor->present)
+        {
+            continue;
+        }
+
+        if (!bc_i2c_memory_read_8b(descriptor->i2c_channel, descriptor->i2c_address, descriptor->probe_register, &value))
+        {
+            continue;
+        }
+
+        if ((value & descriptor->probe_mask) != descriptor->probe_value)
+        {
+            continue;
+        }
+
+        switch (descriptor->type)
+        {
+            case SENSOR_TYPE_TEMPERATURE:
+            {
+                temperature_tag_init(descriptor->i2c_channel, (bc_tag_temperature_i2c_address_t) descriptor->variant, &sensor->tag.temperature);
+                break;
+            }
+            case SENSOR_TYPE_HUMIDITY:
+            {
+                humidity_tag_init((bc_tag_humidity_revision_t) descriptor->variant, descriptor->i2c_channel, &sensor->tag.humidity);
+                break;
+            }
+            case SENSOR_TYPE_LUX_METER:
+            {
+                lux_meter_tag_init(descriptor->i2c_channel, (bc_tag_lux_meter_i2c_address_t) descriptor->variant, &sensor->tag.lux_meter);
+                break;
+            }
+            case SENSOR_TYPE_BAROMETER:
+            {
+                barometer_tag_init(descriptor->i2c_channel, &sensor->tag.barometer);
+                break;
+            }
+            case SENSOR_TYPE_CO2:
+            {
+                co2_module_init();
+                break;
+            }
+            default:
+            {
+                continue;
+            }
+        }
+
+        event_param_t *param = _sensors_param(i);
+
+        if (param != NULL)
+        {
+            param->sensor = i;
+        }
+
+        sensor->present = true;
+
+        _sensors_schedule(i);
+
+        found = true;
+    }
+
+    return found;
+}
+
+static void _sensors_rescan_task(void *param)
+{
+    (void) param;
+
+    // Tags plugged in later are picked up here, the SDK cannot release a tag so removed ones stay
+    if (_sensors_probe())
+    {
+        sensors_publish_inventory();
+    }
+
+    bc_scheduler_plan_current_relative(SENSORS_RESCAN_INTERVAL);
+}
+
+static void _sensors_bus_release(int bus, bc_tick_t now)
+{
+    sensors_bus_t *self = &_sensors_bus[bus];
 
-	static temperature_tag_t temperature_tag_0_0;
-	temperature_tag_init(BC_I2C_I2C0, BC_TAG_TEMPERATURE_I2C_ADDRESS_DEFAULT, &temperature_tag_0_0);
+    if (self->active == SENSORS_NONE)
+    {
+        return;
+    }
 
-	static temperature_tag_t temperature_tag_0_1;
-	temperature_tag_init(BC_I2C_I2C0, BC_TAG_TEMPERATURE_I2C_ADDRESS_ALTERNATE, &temperature_tag_0_1);
+    bc_tick_t started = _sensors[self->active].started;
 
-	static temperature_tag_t temperature_tag_1_0;
-	temperature_tag_init(BC_I2C_I2C1, BC_TAG_TEMPERATURE_I2C_ADDRESS_DEFAULT, &temperature_tag_1_0);
+    self->occupied += (now < self->hold_until ? now : self->hold_until) - started;
 
-	static temperature_tag_t temperature_tag_1_1;
-	temperature_tag_init(BC_I2C_I2C1, BC_TAG_TEMPERATURE_I2C_ADDRESS_ALTERNATE, &temperature_tag_1_1);
+    self->active = SENSORS_NONE;
+}
 
-	//----------------------------
+static void _sensors_bus_task(void *param)
+{
+    (void) param;
 
-	static humidity_tag_t humidity_tag_0_0;
-	humidity_tag_init(BC_TAG_HUMIDITY_REVISION_R1, BC_I2C_I2C0, &humidity_tag_0_0);
+    bc_tick_t now = bc_scheduler_get_spin_tick();
+    bc_tick_t next = BC_TICK_INFINITY;
 
-	static humidity_tag_t humidity_tag_0_2;
-	humidity_tag_init(BC_TAG_HUMIDITY_REVISION_R2, BC_I2C_I2C0, &humidity_tag_0_2);
+    for (int bus = 0; bus < SENSORS_BUS_COUNT; bus++)
+    {
+        sensors_bus_t *self = &_sensors_bus[bus];
 
-	static humidity_tag_t humidity_tag_0_4;
-	humidity_tag_init(BC_TAG_HUMIDITY_REVISION_R3, BC_I2C_I2C0, &humidity_tag_0_4);
+        // Drivers talk to the bus only when triggering and reading, the conversion itself is a scheduler sleep,
+        // so a measurement keeps its bus until it completes or the hold time runs out
+        if (self->active != SENSORS_NONE)
+        {
+            if (now < self->hold_until)
+            {
+                next = self->hold_until < next ? self->hold_until : next;
 
-	static humidity_tag_t humidity_tag_1_0;
-	humidity_tag_init(BC_TAG_HUMIDITY_REVISION_R1, BC_I2C_I2C1, &humidity_tag_1_0);
+                continue;
+            }
 
-	static humidity_tag_t humidity_tag_1_2;
-	humidity_tag_init(BC_TAG_HUMIDITY_REVISION_R2, BC_I2C_I2C1, &humidity_tag_1_2);
+            _sensors_bus_release(bus, now);
+        }
 
-	static humidity_tag_t humidity_tag_1_4;
-	humidity_tag_init(BC_TAG_HUMIDITY_REVISION_R3, BC_I2C_I2C1, &humidity_tag_1_4);
+        int index = SENSORS_NONE;
 
-	//----------------------------
+        for (size_t i = 0; i < SENSORS_COUNT; i++)
+        {
+            sensor_t *sensor = &_sensors[i];
 
-	static lux_meter_tag_t lux_meter_0_0;
-	lux_meter_tag_init(BC_I2C_I2C0, BC_TAG_LUX_METER_I2C_ADDRESS_DEFAULT, &lux_meter_0_0);
+            if (!sensor->present || (sensor->interval == 0) || (_sensors_descriptor[i].i2c_channel != (bc_i2c_channel_t) bus))
+            {
+                continue;
+            }
 
-	static lux_meter_tag_t lux_meter_0_1;
-	lux_meter_tag_init(BC_I2C_I2C0, BC_TAG_LUX_METER_I2C_ADDRESS_ALTERNATE, &lux_meter_0_1);
+            if (sensor->pending)
+            {
+                if (now - sensor->started < SENSORS_MEASURE_TIMEOUT)
+                {
+                    continue;
+                }
 
-	static lux_meter_tag_t lux_meter_1_0;
-	lux_meter_tag_init(BC_I2C_I2C1, BC_TAG_LUX_METER_I2C_ADDRESS_DEFAULT, &lux_meter_1_0);
+                sensor->pending = false;
 
-	static lux_meter_tag_t lux_meter_1_1;
-	lux_meter_tag_init(BC_I2C_I2C1, BC_TAG_LUX_METER_I2C_ADDRESS_ALTERNATE, &lux_meter_1_1);
+                self->errors++;
+            }
 
-	//----------------------------
+            if ((index == SENSORS_NONE) || (sensor->due < _sensors[index].due))
+            {
+                index = i;
+            }
+        }
+
+        if (index == SENSORS_NONE)
+        {
+            continue;
+        }
 
-	static barometer_tag_t barometer_tag_0_0;
-	barometer_tag_init(BC_I2C_I2C0, &barometer_tag_0_0);
+        sensor_t *sensor = &_sensors[index];
 
-	static barometer_tag_t barometer_tag_1_0;
-	barometer_tag_init(BC_I2C_I2C1, &barometer_tag_1_0);
+        if (sensor->due > now)
+        {
+            next = sensor->due < next ? sensor->due : next;
+
+            continue;
+        }
 
-	//----------------------------
+        if (now - sensor->due > self->wait_max)
+        {
+            self->wait_max = now - sensor->due;
+        }
+
+        // Keep the phase unless the sensor fell a whole interval behind
+        sensor->due += sensor->interval;
+
+        if (sensor->due <= now)
+        {
+            sensor->due = now + sensor->interval;
+        }
+
+        if (!_sensors_measure(index))
+        {
+            self->errors++;
+
+            next = now + SENSORS_BUS_SLOT < next ? now + SENSORS_BUS_SLOT : next;
+
+            continue;
+        }
 
-	co2_module_init();
+        sensor->pending = true;
+        sensor->started = now;
 
-	pir_module_init();
+        self->active = index;
+        self->hold_until = now + SENSORS_BUS_HOLD;
+        self->measurements++;
+
+        next = self->hold_until < next ? self->hold_until : next;
+    }
+
+    bc_scheduler_plan_current_absolute(next);
+}
+
+static void _sensors_measure_done(uint8_t index, bool error)
+{
+    sensor_t *sensor = &_sensors[index];
+    int bus = _sensors_descriptor[index].i2c_channel;
+
+    sensor->pending = false;
+
+    // Frames of this sample carry the tick the measurement finished at
+    timestamp_capture(bc_tick_get());
+
+    if (error)
+    {
+        _sensors_bus[bus].errors++;
+    }
+
+    if (_sensors_bus[bus].active == index)
+    {
+        _sensors_bus_release(bus, bc_scheduler_get_spin_tick());
+
+        bc_scheduler_plan_now(_sensors_bus_task_id);
+    }
+}
+
+static void _sensors_adapt(uint8_t index, const value_t *value)
+{
+    const config_sensor_t *config = _sensors_config(index);
+    sensor_t *sensor = &_sensors[index];
+    int32_t change = value_distance(value, &sensor->last);
+
+    sensor->last = *value;
+
+    if (!sensor->sampled)
+    {
+        sensor->sampled = true;
+
+        return;
+    }
+
+    sensor->interval = sampling_next_interval(sensor->interval, change, config);
+
+    // Next due was planned with the previous interval when the measurement started
+    if (sensor->due > sensor->started + sensor->interval)
+    {
+        sensor->due = sensor->started + sensor->interval;
+
+        bc_scheduler_plan_now(_sensors_bus_task_id);
+    }
+}
+
+static const config_sensor_t *_sensors_config(size_t index)
+{
+    event_param_t *param = _sensors_param(index);
+
+    return config_sensor_get(_sensors_descriptor[index].type, param != NULL ? param->channel : 0);
+}
+
+void sensors_apply_config(void)
+{
+    for (size_t i = 0; i < SENSORS_COUNT; i++)
+    {
+        sensor_t *sensor = &_sensors[i];
+
+        if (!sensor->present)
+        {
+            continue;
+        }
+
+        const config_sensor_t *config = _sensors_config(i);
+
+        if (_sensors_descriptor[i].type == SENSOR_TYPE_CO2)
+        {
+            bc_module_co2_set_update_interval((bc_tick_t) config->interval_min * 1000);
+
+            continue;
+        }
+
+        if (sensor->interval < (bc_tick_t) config->interval_min * 1000)
+        {
+            sensor->interval = (bc_tick_t) config->interval_min * 1000;
+        }
+        else if (sensor->interval > (bc_tick_t) config->interval_max * 1000)
+        {
+            sensor->interval = (bc_tick_t) config->interval_max * 1000;
+        }
+
+        if (sensor->due > bc_scheduler_get_spin_tick() + sensor->interval)
+        {
+            sensor->due = bc_scheduler_get_spin_tick() + sensor->interval;
+        }
+    }
+
+    bc_scheduler_plan_now(_sensors_bus_task_id);
 }
 
 static void temperature_tag_event_handler(bc_tag_temperature_t *self, bc_tag_temperature_event_t event, void *event_param)
 {
-    float value;
+    float celsius;
     event_param_t *param = (event_param_t *)event_param;
 
+    _sensors_measure_done(param->sensor, event != BC_TAG_TEMPERATURE_EVENT_UPDATE);
+
     if (event != BC_TAG_TEMPERATURE_EVENT_UPDATE)
     {
         return;
     }
 
-    if (bc_tag_temperature_get_temperature_celsius(self, &value))
+    if (bc_tag_temperature_get_temperature_celsius(self, &celsius))
     {
-        if ((fabs(value - param->value) >= TEMPERATURE_TAG_PUB_VALUE_CHANGE) || (param->next_pub < bc_scheduler_get_spin_tick()))
+        value_t value = VALUE_TEMPERATURE(celsius);
+
+        _sensors_adapt(param->sensor, &value);
+
+        if (!stream_update(_device_address, STREAM_KIND_TEMPERATURE, param->channel, &value))
+        {
+            return;
+        }
+
+        const config_sensor_t *config = config_sensor_get(SENSOR_TYPE_TEMPERATURE, param->channel);
+
+        if ((value_distance(&value, &param->value) >= config->value_change) || (param->next_pub < bc_scheduler_get_spin_tick()))
         {
         	usb_talk_publish_temperature(_device_address, param->channel, &value);
 
             param->value = value;
-            param->next_pub = bc_scheduler_get_spin_tick() + TEMPERATURE_TAG_PUB_NO_CHANGE_INTEVAL;
+            param->next_pub = bc_scheduler_get_spin_tick() + (bc_tick_t) config->no_change_interval * 1000;
         }
     }
 }
@@ -97,31 +627,47 @@ void temperature_tag_init(bc_i2c_channel_t i2c_channel, bc_tag_temperature_i2c_a
 
     tag->param.channel = i2c_address == BC_TAG_TEMPERATURE_I2C_ADDRESS_DEFAULT ? BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_DEFAULT: BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_ALTERNATE;
 
-    bc_tag_temperature_init(&tag->self, i2c_channel, i2c_address);
+    if (i2c_channel == BC_I2C_I2C1)
+    {
+        tag->param.channel |= 0x80;
+    }
 
-    bc_tag_temperature_set_update_interval(&tag->self, TEMPERATURE_TAG_UPDATE_INTERVAL);
+    bc_tag_temperature_init(&tag->self, i2c_channel, i2c_address);
 
     bc_tag_temperature_set_event_handler(&tag->self, temperature_tag_event_handler, &tag->param);
 }
 
 static void humidity_tag_event_handler(bc_tag_humidity_t *self, bc_tag_humidity_event_t event, void *event_param)
 {
-    float value;
+    float percentage;
     event_param_t *param = (event_param_t *)event_param;
 
+    _sensors_measure_done(param->sensor, event != BC_TAG_HUMIDITY_EVENT_UPDATE);
+
     if (event != BC_TAG_HUMIDITY_EVENT_UPDATE)
     {
         return;
     }
 
-    if (bc_tag_humidity_get_humidity_percentage(self, &value))
+    if (bc_tag_humidity_get_humidity_percentage(self, &percentage))
     {
-        if ((fabs(value - param->value) >= HUMIDITY_TAG_PUB_VALUE_CHANGE) || (param->next_pub < bc_scheduler_get_spin_tick()))
+        value_t value = VALUE_HUMIDITY(percentage);
+
+        _sensors_adapt(param->sensor, &value);
+
+        if (!stream_update(_device_address, STREAM_KIND_HUMIDITY, param->channel, &value))
+        {
+            return;
+        }
+
+        const config_sensor_t *config = config_sensor_get(SENSOR_TYPE_HUMIDITY, param->channel);
+
+        if ((value_distance(&value, &param->value) >= config->value_change) || (param->next_pub < bc_scheduler_get_spin_tick()))
         {
         	 usb_talk_publish_humidity(_device_address, param->channel, &value);
 
             param->value = value;
-            param->next_pub = bc_scheduler_get_spin_tick() + HUMIDITY_TAG_PUB_NO_CHANGE_INTEVAL;
+            param->next_pub = bc_scheduler_get_spin_tick() + (bc_tick_t) config->no_change_interval * 1000;
         }
     }
 }
@@ -154,29 +700,40 @@ void humidity_tag_init(bc_tag_humidity_revision_t revision, bc_i2c_channel_t i2c
 
     bc_tag_humidity_init(&tag->self, revision, i2c_channel, BC_TAG_HUMIDITY_I2C_ADDRESS_DEFAULT);
 
-    bc_tag_humidity_set_update_interval(&tag->self, HUMIDITY_TAG_UPDATE_INTERVAL);
-
     bc_tag_humidity_set_event_handler(&tag->self, humidity_tag_event_handler, &tag->param);
 }
 
 static void lux_meter_event_handler(bc_tag_lux_meter_t *self, bc_tag_lux_meter_event_t event, void *event_param)
 {
-    float value;
+    float illuminance;
     event_param_t *param = (event_param_t *)event_param;
 
+    _sensors_measure_done(param->sensor, event != BC_TAG_LUX_METER_EVENT_UPDATE);
+
     if (event != BC_TAG_LUX_METER_EVENT_UPDATE)
     {
         return;
     }
 
-    if (bc_tag_lux_meter_get_illuminance_lux(self, &value))
+    if (bc_tag_lux_meter_get_illuminance_lux(self, &illuminance))
     {
-        if ((fabs(value - param->value) >= LUX_METER_TAG_PUB_VALUE_CHANGE) || (param->next_pub < bc_scheduler_get_spin_tick()))
+        value_t value = VALUE_ILLUMINANCE(illuminance);
+
+        _sensors_adapt(param->sensor, &value);
+
+        if (!stream_update(_device_address, STREAM_KIND_LUX_METER, param->channel, &value))
+        {
+            return;
+        }
+
+        const config_sensor_t *config = config_sensor_get(SENSOR_TYPE_LUX_METER, param->channel);
+
+        if ((value_distance(&value, &param->value) >= config->value_change) || (param->next_pub < bc_scheduler_get_spin_tick()))
         {
         	 usb_talk_publish_lux_meter(_device_address, param->channel, &value);
 
             param->value = value;
-            param->next_pub = bc_scheduler_get_spin_tick() + LUX_METER_TAG_PUB_NO_CHANGE_INTEVAL;
+            param->next_pub = bc_scheduler_get_spin_tick() + (bc_tick_t) config->no_change_interval * 1000;
         }
     }
 }
@@ -187,40 +744,58 @@ void lux_meter_tag_init(bc_i2c_channel_t i2c_channel, bc_tag_lux_meter_i2c_addre
 
     tag->param.channel = i2c_address == BC_TAG_LUX_METER_I2C_ADDRESS_DEFAULT ? BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_DEFAULT: BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_ALTERNATE;
 
-    bc_tag_lux_meter_init(&tag->self, i2c_channel, i2c_address);
+    if (i2c_channel == BC_I2C_I2C1)
+    {
+        tag->param.channel |= 0x80;
+    }
 
-    bc_tag_lux_meter_set_update_interval(&tag->self, LUX_METER_TAG_UPDATE_INTERVAL);
+    bc_tag_lux_meter_init(&tag->self, i2c_channel, i2c_address);
 
     bc_tag_lux_meter_set_event_handler(&tag->self, lux_meter_event_handler, &tag->param);
 }
 
 static void barometer_tag_event_handler(bc_tag_barometer_t *self, bc_tag_barometer_event_t event, void *event_param)
 {
-    float pascal;
-    float meter;
+    float pressure;
+    float altitude;
     event_param_t *param = (event_param_t *)event_param;
 
+    _sensors_measure_done(param->sensor, event != BC_TAG_BAROMETER_EVENT_UPDATE);
+
     if (event != BC_TAG_BAROMETER_EVENT_UPDATE)
     {
         return;
     }
 
-    if (!bc_tag_barometer_get_pressure_pascal(self, &pascal))
+    if (!bc_tag_barometer_get_pressure_pascal(self, &pressure))
+    {
+        return;
+    }
+
+    value_t pascal = VALUE_PRESSURE(pressure);
+
+    _sensors_adapt(param->sensor, &pascal);
+
+    if (!stream_update(_device_address, STREAM_KIND_PRESSURE, param->channel, &pascal))
     {
         return;
     }
 
-    if ((fabs(pascal - param->value) >= BAROMETER_TAG_PUB_VALUE_CHANGE) || (param->next_pub < bc_scheduler_get_spin_tick()))
+    const config_sensor_t *config = config_sensor_get(SENSOR_TYPE_BAROMETER, param->channel);
+
+    if ((value_distance(&pascal, &param->value) >= config->value_change) || (param->next_pub < bc_scheduler_get_spin_tick()))
     {
-        if (!bc_tag_barometer_get_altitude_meter(self, &meter))
+        if (!bc_tag_barometer_get_altitude_meter(self, &altitude))
         {
             return;
         }
 
+        value_t meter = VALUE_ALTITUDE(altitude);
+
         usb_talk_publish_barometer(_device_address, param->channel, &pascal, &meter);
 
         param->value = pascal;
-        param->next_pub = bc_scheduler_get_spin_tick() + BAROMETER_TAG_PUB_NO_CHANGE_INTEVAL;
+        param->next_pub = bc_scheduler_get_spin_tick() + (bc_tick_t) config->no_change_interval * 1000;
     }
 }
 
@@ -230,9 +805,12 @@ void barometer_tag_init(bc_i2c_channel_t i2c_channel, barometer_tag_t *tag)
 
     tag->param.channel = BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_DEFAULT;
 
-    bc_tag_barometer_init(&tag->self, i2c_channel);
+    if (i2c_channel == BC_I2C_I2C1)
+    {
+        tag->param.channel |= 0x80;
+    }
 
-    bc_tag_barometer_set_update_interval(&tag->self, BAROMETER_TAG_UPDATE_INTERVAL);
+    bc_tag_barometer_init(&tag->self, i2c_channel);
 
     bc_tag_barometer_set_event_handler(&tag->self, barometer_tag_event_handler, &tag->param);
 }
@@ -240,17 +818,28 @@ void barometer_tag_init(bc_i2c_channel_t i2c_channel, barometer_tag_t *tag)
 void co2_event_handler(bc_module_co2_event_t event, void *event_param)
 {
     event_param_t *param = (event_param_t *) event_param;
-    float value;
+    float concentration;
 
     if (event == BC_MODULE_CO2_EVENT_UPDATE)
     {
-        if (bc_module_co2_get_concentration_ppm(&value))
+        timestamp_capture(bc_tick_get());
+
+        if (!bc_module_co2_get_concentration_ppm(&concentration))
         {
-            if ((fabs(value - param->value) >= CO2_PUB_VALUE_CHANGE) || (param->next_pub < bc_scheduler_get_spin_tick()))
+            return;
+        }
+
+        value_t value = VALUE_CONCENTRATION(concentration);
+
+        if (stream_update(_device_address, STREAM_KIND_CO2, 0, &value))
+        {
+            const config_sensor_t *config = config_sensor_get(SENSOR_TYPE_CO2, 0);
+
+            if ((value_distance(&value, &param->value) >= config->value_change) || (param->next_pub < bc_scheduler_get_spin_tick()))
             {
                 usb_talk_publish_co2(_device_address, &value);
                 param->value = value;
-                param->next_pub = bc_scheduler_get_spin_tick() + CO2_PUB_NO_CHANGE_INTERVAL;
+                param->next_pub = bc_scheduler_get_spin_tick() + (bc_tick_t) config->no_change_interval * 1000;
             }
         }
     }
@@ -260,7 +849,7 @@ void co2_module_init(void)
 {
     static event_param_t event_param = { .next_pub = 0 };
     bc_module_co2_init();
-    bc_module_co2_set_update_interval(CO2_UPDATE_INTERVAL);
+    bc_module_co2_set_update_interval((bc_tick_t) config_sensor_get(SENSOR_TYPE_CO2, 0)->interval_min * 1000);
     bc_module_co2_set_event_handler(co2_event_handler, &event_param);
 }
 
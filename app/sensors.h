@@ -3,31 +3,67 @@
 
 #include <bc_common.h>
 #include <bcl.h>
+#include <value.h>
 
 #define TEMPERATURE_TAG_PUB_NO_CHANGE_INTEVAL (5 * 60 * 1000)
 #define TEMPERATURE_TAG_PUB_VALUE_CHANGE 0.1f
-#define TEMPERATURE_TAG_UPDATE_INTERVAL (1 * 1000)
+#define TEMPERATURE_TAG_UPDATE_INTERVAL_MIN (1 * 1000)
+#define TEMPERATURE_TAG_UPDATE_INTERVAL_MAX (30 * 1000)
 
 #define HUMIDITY_TAG_PUB_NO_CHANGE_INTEVAL (5 * 60 * 1000)
 #define HUMIDITY_TAG_PUB_VALUE_CHANGE 1.0f
-#define HUMIDITY_TAG_UPDATE_INTERVAL (1 * 1000)
+#define HUMIDITY_TAG_UPDATE_INTERVAL_MIN (1 * 1000)
+#define HUMIDITY_TAG_UPDATE_INTERVAL_MAX (30 * 1000)
 
 #define LUX_METER_TAG_PUB_NO_CHANGE_INTEVAL (5 * 60 * 1000)
 #define LUX_METER_TAG_PUB_VALUE_CHANGE 5.0f
-#define LUX_METER_TAG_UPDATE_INTERVAL (1 * 1000)
+#define LUX_METER_TAG_UPDATE_INTERVAL_MIN (1 * 1000)
+#define LUX_METER_TAG_UPDATE_INTERVAL_MAX (10 * 1000)
 
 #define BAROMETER_TAG_PUB_NO_CHANGE_INTEVAL (5 * 60 * 1000)
 #define BAROMETER_TAG_PUB_VALUE_CHANGE 10.0f
-#define BAROMETER_TAG_UPDATE_INTERVAL (1 * 1000)
+#define BAROMETER_TAG_UPDATE_INTERVAL_MIN (1 * 1000)
+#define BAROMETER_TAG_UPDATE_INTERVAL_MAX (60 * 1000)
 
 #define CO2_PUB_NO_CHANGE_INTERVAL (5 * 60 * 1000)
 #define CO2_PUB_VALUE_CHANGE 50.0f
 #define CO2_UPDATE_INTERVAL (15 * 1000)
 
+#define SENSORS_RESCAN_INTERVAL (30 * 1000)
+
+#define SENSORS_BUS_COUNT 2
+#define SENSORS_BUS_SLOT 100
+#define SENSORS_BUS_HOLD 50
+#define SENSORS_MEASURE_TIMEOUT (5 * 1000)
+
+typedef enum
+{
+    SENSOR_TYPE_TEMPERATURE = 0,
+    SENSOR_TYPE_HUMIDITY = 1,
+    SENSOR_TYPE_LUX_METER = 2,
+    SENSOR_TYPE_BAROMETER = 3,
+    SENSOR_TYPE_CO2 = 4,
+    SENSOR_TYPE_COUNT = 5
+
+} sensor_type_t;
+
+typedef struct
+{
+    sensor_type_t type;
+    bc_i2c_channel_t i2c_channel;
+    uint8_t i2c_address;
+    uint8_t variant;
+    uint8_t probe_register;
+    uint8_t probe_mask;
+    uint8_t probe_value;
+
+} sensor_descriptor_t;
+
 typedef struct
 {
     uint8_t channel;
-    float value;
+    uint8_t sensor;
+    value_t value;
     bc_tick_t next_pub;
 
 } event_param_t;
@@ -62,6 +98,14 @@ typedef struct
 
 void sensors_init_all(uint64_t *my_device_address);
 
+void sensors_publish_inventory(void);
+
+void sensors_publish_bus(void);
+
+void sensors_apply_config(void);
+
+const char *sensors_get_type_name(sensor_type_t type);
+
 void temperature_tag_init(bc_i2c_channel_t i2c_channel, bc_tag_temperature_i2c_address_t i2c_address, temperature_tag_t *tag);
 
 void humidity_tag_init(bc_tag_humidity_revision_t revision, bc_i2c_channel_t i2c_channel, humidity_tag_t *tag);
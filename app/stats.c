@@ -0,0 +1,85 @@
+#include <stats.h>
+#include <usb_talk.h>
+#include <node_stats.h>
+#include <profile.h>
+
+// Counters live in the modules that update them, this only reads and formats them
+static struct
+{
+    bc_tick_t interval;
+    bc_scheduler_task_id_t task_id;
+
+} _stats;
+
+static void _stats_task(void *param);
+
+void stats_init(void)
+{
+    memset(&_stats, 0, sizeof(_stats));
+
+    _stats.task_id = PROFILE_REGISTER(_stats_task, NULL, BC_TICK_INFINITY);
+}
+
+void stats_set_interval(bc_tick_t interval)
+{
+    if (interval == 0)
+    {
+        _stats.interval = 0;
+
+        bc_scheduler_plan_absolute(_stats.task_id, BC_TICK_INFINITY);
+
+        return;
+    }
+
+    _stats.interval = interval < STATS_INTERVAL_MIN ? STATS_INTERVAL_MIN : interval;
+
+    bc_scheduler_plan_relative(_stats.task_id, _stats.interval);
+}
+
+void stats_publish(void)
+{
+    const usb_talk_stats_t *talk = usb_talk_get_stats();
+
+    usb_talk_message_start("/stats");
+
+    usb_talk_message_append("{\"uptime\": %lu, ", (unsigned long) bc_tick_get());
+
+    usb_talk_message_append("\"rx\": {\"messages\": %lu, \"bytes\": %lu}, ",
+            (unsigned long) talk->rx_messages, (unsigned long) talk->rx_bytes);
+
+    usb_talk_message_append("\"tx\": {\"messages\": %lu, \"bytes\": %lu, \"drops\": %lu}, ",
+            (unsigned long) talk->tx_messages, (unsigned long) talk->tx_bytes, (unsigned long) talk->tx_drops);
+
+    usb_talk_message_append("\"errors\": {\"overflow\": %lu, \"json\": %lu, \"format\": %lu, \"address\": %lu}, ",
+            (unsigned long) talk->rx_overflow, (unsigned long) talk->rx_json, (unsigned long) talk->rx_format, (unsigned long) talk->rx_address);
+
+    usb_talk_message_append("\"dispatch-miss\": %lu, \"radio\": {", (unsigned long) talk->dispatch_miss);
+
+    for (int i = 0; i < NODE_STATS_PACKET_COUNT; i++)
+    {
+        usb_talk_message_append("%s\"%s\": %lu", i == 0 ? "" : ", ", node_stats_get_packet_name(i), (unsigned long) node_stats_get_total(i));
+    }
+
+    usb_talk_message_append("}}");
+
+    usb_talk_message_send();
+}
+
+void stats_publish_config(void)
+{
+    usb_talk_send_format("[\"/stats/config\", {\"interval\": %lu}]\n", (unsigned long) (_stats.interval / 1000));
+}
+
+static void _stats_task(void *param)
+{
+    (void) param;
+
+    if (_stats.interval == 0)
+    {
+        return;
+    }
+
+    stats_publish();
+
+    bc_scheduler_plan_current_relative(_stats.interval);
+}
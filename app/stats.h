@@ -0,0 +1,18 @@
+#ifndef _STATS_H
+#define _STATS_H
+
+#include <bc_common.h>
+#include <bc_tick.h>
+
+#define STATS_INTERVAL_MIN (10 * 1000)
+
+void stats_init(void);
+
+// Publishes the stats frame every interval, zero stops it
+void stats_set_interval(bc_tick_t interval);
+
+void stats_publish(void);
+
+void stats_publish_config(void);
+
+#endif
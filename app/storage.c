@@ -0,0 +1,308 @@
+#include <storage.h>
+#include <alias.h>
+#include <config.h>
+#include <group.h>
+#include <usb_talk.h>
+#include <profile.h>
+#include <bcl.h>
+
+// EEPROM map from the bottom up, the modules check that their records fit their region
+_Static_assert(ALIAS_EEPROM_ADDRESS + ALIAS_EEPROM_SIZE <= GROUP_EEPROM_ADDRESS, "alias and group regions overlap");
+_Static_assert(GROUP_EEPROM_ADDRESS + GROUP_EEPROM_SIZE <= CONFIG_EEPROM_ADDRESS, "group and config regions overlap");
+_Static_assert(CONFIG_EEPROM_ADDRESS + CONFIG_EEPROM_SIZE <= STORAGE_PEER_ADDRESS, "config region overlaps radio peers");
+
+typedef struct
+{
+    uint32_t address;
+    uint8_t length;
+    uint8_t offset;
+    uint8_t data[STORAGE_ENTRY_SIZE];
+
+} storage_entry_t;
+
+// Write-back queue in front of bc_eeprom_write, committed in order so a header queued
+// before a record still lands first. A write inside a queued range patches it in place.
+static struct
+{
+    storage_entry_t entry[STORAGE_ENTRY_COUNT];
+    int count;
+    bc_scheduler_task_id_t task_id;
+    bool planned;
+
+    uint32_t requests;
+    uint32_t avoided;
+    uint32_t coalesced;
+    uint32_t chunks;
+    uint32_t written;
+    uint32_t skipped;
+    uint32_t errors;
+
+} _storage;
+
+static void _storage_task(void *param);
+static int _storage_parts(uint32_t address, const uint8_t *data, size_t length, bool enqueue);
+static bool _storage_reserve(int count);
+static void _storage_enqueue(uint32_t address, const uint8_t *data, size_t length);
+static bool _storage_commit(storage_entry_t *entry, bool all);
+static void _storage_shift(void);
+
+void storage_init(void)
+{
+    memset(&_storage, 0, sizeof(_storage));
+
+    _storage.task_id = PROFILE_REGISTER(_storage_task, NULL, BC_TICK_INFINITY);
+}
+
+bool storage_write(uint32_t address, const void *buffer, size_t length)
+{
+    _storage.requests++;
+
+    // Room for every part first, a write refused halfway would leave part of a record queued
+    int needed = _storage_parts(address, buffer, length, false);
+
+    if (needed == 0)
+    {
+        _storage.avoided++;
+        _storage.skipped += length;
+
+        return true;
+    }
+
+    if (!_storage_reserve(needed))
+    {
+        return false;
+    }
+
+    _storage_parts(address, buffer, length, true);
+
+    if (!_storage.planned)
+    {
+        _storage.planned = true;
+
+        bc_scheduler_plan_relative(_storage.task_id, STORAGE_DELAY);
+    }
+
+    return true;
+}
+
+void storage_read(uint32_t address, void *buffer, size_t length)
+{
+    uint8_t *data = buffer;
+
+    bc_eeprom_read(address, buffer, length);
+
+    for (int i = 0; i < _storage.count; i++)
+    {
+        storage_entry_t *entry = &_storage.entry[i];
+        uint32_t start = entry->address > address ? entry->address : address;
+        uint32_t end = entry->address + entry->length < address + length ? entry->address + entry->length : address + length;
+
+        if (start < end)
+        {
+            memcpy(data + (start - address), entry->data + (start - entry->address), end - start);
+        }
+    }
+}
+
+bool storage_flush(void)
+{
+    bool result = true;
+
+    while (_storage.count > 0)
+    {
+        result &= _storage_commit(&_storage.entry[0], true);
+
+        _storage_shift();
+    }
+
+    return result;
+}
+
+void storage_publish(void)
+{
+    usb_talk_send_format("[\"/storage\", {\"pending\": %d, \"requests\": %lu, \"avoided\": %lu, \"coalesced\": %lu, "
+            "\"chunks\": %lu, \"written\": %lu, \"skipped\": %lu, \"errors\": %lu}]\n",
+            _storage.count, (unsigned long) _storage.requests, (unsigned long) _storage.avoided, (unsigned long) _storage.coalesced,
+            (unsigned long) _storage.chunks, (unsigned long) _storage.written, (unsigned long) _storage.skipped, (unsigned long) _storage.errors);
+}
+
+static void _storage_task(void *param)
+{
+    (void) param;
+
+    if (_storage.count == 0)
+    {
+        _storage.planned = false;
+
+        return;
+    }
+
+    _storage_commit(&_storage.entry[0], false);
+
+    if (_storage.entry[0].offset == _storage.entry[0].length)
+    {
+        _storage_shift();
+    }
+
+    if (_storage.count == 0)
+    {
+        _storage.planned = false;
+
+        return;
+    }
+
+    // One chunk per run, the radio and USB tasks get their turn in between
+    bc_scheduler_plan_current_now();
+}
+
+// Parts of the buffer that differ from what the EEPROM will hold, one entry each at most
+static int _storage_parts(uint32_t address, const uint8_t *data, size_t length, bool enqueue)
+{
+    uint8_t current[STORAGE_ENTRY_SIZE];
+    int count = 0;
+
+    while (length > 0)
+    {
+        size_t part = length < STORAGE_ENTRY_SIZE ? length : STORAGE_ENTRY_SIZE;
+
+        storage_read(address, current, part);
+
+        size_t first = 0;
+        size_t last = part;
+
+        while ((first < part) && (current[first] == data[first]))
+        {
+            first++;
+        }
+
+        while ((last > first) && (current[last - 1] == data[last - 1]))
+        {
+            last--;
+        }
+
+        if (first < last)
+        {
+            if (enqueue)
+            {
+                _storage_enqueue(address + first, data + first, last - first);
+            }
+
+            count++;
+        }
+
+        if (enqueue)
+        {
+            _storage.skipped += part - (last - first);
+        }
+
+        address += part;
+        data += part;
+        length -= part;
+    }
+
+    return count;
+}
+
+static bool _storage_reserve(int count)
+{
+    if (count > STORAGE_ENTRY_COUNT)
+    {
+        return false;
+    }
+
+    // Queue full, the oldest entries are written in place
+    while (_storage.count + count > STORAGE_ENTRY_COUNT)
+    {
+        bool result = _storage_commit(&_storage.entry[0], true);
+
+        _storage_shift();
+
+        if (!result)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void _storage_enqueue(uint32_t address, const uint8_t *data, size_t length)
+{
+    // Only the newest entry may be patched, an older one would be reordered behind it
+    if (_storage.count > 0)
+    {
+        storage_entry_t *entry = &_storage.entry[_storage.count - 1];
+
+        if ((address >= entry->address + entry->offset) && (address + length <= entry->address + entry->length))
+        {
+            memcpy(entry->data + (address - entry->address), data, length);
+
+            _storage.coalesced++;
+
+            return;
+        }
+    }
+
+    storage_entry_t *entry = &_storage.entry[_storage.count++];
+
+    entry->address = address;
+    entry->length = (uint8_t) length;
+    entry->offset = 0;
+
+    memcpy(entry->data, data, length);
+}
+
+static bool _storage_commit(storage_entry_t *entry, bool all)
+{
+    uint8_t current[STORAGE_CHUNK_SIZE];
+
+    while (entry->offset < entry->length)
+    {
+        uint32_t address = entry->address + entry->offset;
+
+        // Chunks end on a word boundary, the EEPROM is programmed per word
+        size_t length = STORAGE_CHUNK_SIZE - (address % STORAGE_CHUNK_SIZE);
+
+        if (length > (size_t) (entry->length - entry->offset))
+        {
+            length = entry->length - entry->offset;
+        }
+
+        bc_eeprom_read(address, current, length);
+
+        if (memcmp(current, entry->data + entry->offset, length) == 0)
+        {
+            _storage.skipped += length;
+            entry->offset += length;
+
+            continue;
+        }
+
+        // A failed entry is dropped, retrying could stall the queue for good
+        if (!bc_eeprom_write(address, entry->data + entry->offset, length))
+        {
+            _storage.errors++;
+            entry->offset = entry->length;
+
+            return false;
+        }
+
+        _storage.chunks++;
+        _storage.written += length;
+        entry->offset += length;
+
+        if (!all)
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+static void _storage_shift(void)
+{
+    _storage.count--;
+
+    memmove(&_storage.entry[0], &_storage.entry[1], _storage.count * sizeof(_storage.entry[0]));
+}
@@ -0,0 +1,30 @@
+#ifndef _STORAGE_H
+#define _STORAGE_H
+
+#include <bc_common.h>
+
+#define STORAGE_ENTRY_COUNT 8
+#define STORAGE_ENTRY_SIZE 40
+#define STORAGE_CHUNK_SIZE 4
+#define STORAGE_DELAY 50
+
+// The SDK keeps paired radio peers at the top of the EEPROM, 24 bytes each growing down
+// from 8 bytes below the end, the regions of the application have to stay under them
+#define STORAGE_EEPROM_SIZE 0x1800
+#define STORAGE_PEER_SIZE 24
+#define STORAGE_PEER_ADDRESS (STORAGE_EEPROM_SIZE - 8 - BC_RADIO_MAX_DEVICES * STORAGE_PEER_SIZE)
+
+void storage_init(void);
+
+// Queues the bytes that differ from what the EEPROM will hold, the task writes them one chunk per run
+bool storage_write(uint32_t address, const void *buffer, size_t length);
+
+// EEPROM contents with the queued writes applied
+void storage_read(uint32_t address, void *buffer, size_t length);
+
+// Writes everything queued before returning
+bool storage_flush(void);
+
+void storage_publish(void);
+
+#endif
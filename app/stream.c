@@ -0,0 +1,296 @@
+#include <stream.h>
+#include <history.h>
+#include <usb_talk.h>
+#include <profile.h>
+#include <trace.h>
+#include <timestamp.h>
+#include <bc_radio_pub.h>
+#include <bcl.h>
+
+typedef struct
+{
+    uint64_t id;
+    bc_tick_t updated;
+    value_t latest;
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint16_t count;
+    uint8_t kind;
+    uint8_t channel;
+    bool used;
+
+} stream_t;
+
+typedef struct
+{
+    const char *name;
+    const char *quantity;
+
+} stream_kind_info_t;
+
+static const stream_kind_info_t _stream_kind_info[STREAM_KIND_COUNT] = {
+    [STREAM_KIND_TEMPERATURE] = { "thermometer", "temperature" },
+    [STREAM_KIND_HUMIDITY] = { "hygrometer", "relative-humidity" },
+    [STREAM_KIND_LUX_METER] = { "lux-meter", "illuminance" },
+    [STREAM_KIND_PRESSURE] = { "barometer", "pressure" },
+    [STREAM_KIND_CO2] = { "co2-meter", "concentration" },
+    [STREAM_KIND_VOLTAGE] = { "battery", "voltage" }
+};
+
+// Every stream keeps only the running min, max and sum of the current window in raw fixed point,
+// the window is closed and published every period, so memory does not depend on the sample rate
+static struct
+{
+    stream_t stream[STREAM_COUNT];
+    bc_tick_t period;
+    bool raw;
+    bc_scheduler_task_id_t task_id;
+    void (*update_handler)(int, void *);
+    void *update_param;
+    uint32_t evicted;
+
+} _stream;
+
+static void _stream_task(void *param);
+static void _stream_publish(stream_t *stream);
+
+void stream_init(void)
+{
+    memset(&_stream, 0, sizeof(_stream));
+
+    _stream.period = STREAM_PERIOD;
+    _stream.raw = true;
+
+    _stream.task_id = PROFILE_REGISTER(_stream_task, NULL, STREAM_PERIOD);
+}
+
+void stream_set_update_handler(void (*handler)(int index, void *param), void *param)
+{
+    _stream.update_handler = handler;
+    _stream.update_param = param;
+}
+
+bool stream_update(uint64_t *id, stream_kind_t kind, uint8_t channel, const value_t *value)
+{
+    stream_t *stream = NULL;
+    stream_t *victim = NULL;
+
+    for (int i = 0; i < STREAM_COUNT; i++)
+    {
+        stream_t *item = &_stream.stream[i];
+
+        if (!item->used)
+        {
+            if (victim == NULL || victim->used)
+            {
+                victim = item;
+            }
+
+            continue;
+        }
+
+        if ((item->id == *id) && (item->kind == kind) && (item->channel == channel))
+        {
+            stream = item;
+
+            break;
+        }
+
+        if ((victim == NULL) || (victim->used && (item->updated < victim->updated)))
+        {
+            victim = item;
+        }
+    }
+
+    if (stream == NULL)
+    {
+        // Table full, the stream that was quiet for the longest time gives way,
+        // its open window is published early instead of being lost
+        stream = victim;
+
+        if (stream->used)
+        {
+            if (stream->count > 0)
+            {
+                bc_tick_t received = timestamp_get();
+
+                _stream_publish(stream);
+
+                // The stats frame took over the capture of this packet
+                trace_cancel();
+                timestamp_capture(received);
+            }
+
+            _stream.evicted++;
+        }
+
+        memset(stream, 0, sizeof(*stream));
+
+        stream->id = *id;
+        stream->kind = kind;
+        stream->channel = channel;
+        stream->used = true;
+    }
+
+    if ((stream->count == 0) || (value->raw < stream->min))
+    {
+        stream->min = value->raw;
+    }
+
+    if ((stream->count == 0) || (value->raw > stream->max))
+    {
+        stream->max = value->raw;
+    }
+
+    if (stream->count < UINT16_MAX)
+    {
+        stream->sum += value->raw;
+        stream->count++;
+    }
+
+    stream->latest = *value;
+    stream->updated = timestamp_get();
+
+    history_record(id, kind, channel, value);
+
+    if (_stream.update_handler != NULL)
+    {
+        _stream.update_handler(stream - _stream.stream, _stream.update_param);
+    }
+
+    return _stream.raw;
+}
+
+void stream_forget(uint64_t *id)
+{
+    for (int i = 0; i < STREAM_COUNT; i++)
+    {
+        if (_stream.stream[i].used && (_stream.stream[i].id == *id))
+        {
+            _stream.stream[i].used = false;
+
+            if (_stream.update_handler != NULL)
+            {
+                _stream.update_handler(i, _stream.update_param);
+            }
+        }
+    }
+}
+
+bool stream_get(int index, uint64_t *id, stream_kind_t *kind, uint8_t *channel, value_t *latest)
+{
+    if ((index < 0) || (index >= STREAM_COUNT) || !_stream.stream[index].used)
+    {
+        return false;
+    }
+
+    *id = _stream.stream[index].id;
+    *kind = _stream.stream[index].kind;
+    *channel = _stream.stream[index].channel;
+    *latest = _stream.stream[index].latest;
+
+    return true;
+}
+
+void stream_set_period(bc_tick_t period)
+{
+    _stream.period = period < STREAM_PERIOD_MIN ? STREAM_PERIOD_MIN : period;
+
+    bc_scheduler_plan_relative(_stream.task_id, _stream.period);
+}
+
+void stream_set_raw(bool raw)
+{
+    _stream.raw = raw;
+}
+
+int stream_format_topic(char *buffer, size_t size, stream_kind_t kind, uint8_t channel)
+{
+    const stream_kind_info_t *info = &_stream_kind_info[kind];
+
+    if ((kind == STREAM_KIND_CO2) || (kind == STREAM_KIND_VOLTAGE))
+    {
+        return snprintf(buffer, size, "%s/-/%s", info->name, info->quantity);
+    }
+    else if ((kind == STREAM_KIND_TEMPERATURE) && (channel == BC_RADIO_PUB_CHANNEL_A))
+    {
+        return snprintf(buffer, size, "%s/a/%s", info->name, info->quantity);
+    }
+    else if ((kind == STREAM_KIND_TEMPERATURE) && (channel == BC_RADIO_PUB_CHANNEL_B))
+    {
+        return snprintf(buffer, size, "%s/b/%s", info->name, info->quantity);
+    }
+    else if ((kind == STREAM_KIND_TEMPERATURE) && (channel == BC_RADIO_PUB_CHANNEL_SET_POINT))
+    {
+        return snprintf(buffer, size, "%s/set-point/%s", info->name, info->quantity);
+    }
+
+    return snprintf(buffer, size, "%s/%d:%d/%s", info->name, ((channel & 0x80) >> 7), (channel & ~0x80), info->quantity);
+}
+
+void stream_publish_config(void)
+{
+    usb_talk_send_format("[\"/stream/config\", {\"period\": %lu, \"raw\": %s, \"evicted\": %" PRIu32 "}]\n",
+            (unsigned long) (_stream.period / 1000), _stream.raw ? "true" : "false", _stream.evicted);
+}
+
+void stream_publish_stats(void)
+{
+    for (int i = 0; i < STREAM_COUNT; i++)
+    {
+        stream_t *stream = &_stream.stream[i];
+
+        if (!stream->used || (stream->count == 0))
+        {
+            continue;
+        }
+
+        _stream_publish(stream);
+
+        stream->count = 0;
+        stream->sum = 0;
+    }
+
+    trace_cancel();
+    timestamp_capture_cancel();
+}
+
+static void _stream_task(void *param)
+{
+    (void) param;
+
+    stream_publish_stats();
+
+    bc_scheduler_plan_current_relative(_stream.period);
+}
+
+static void _stream_publish(stream_t *stream)
+{
+    char topic[STREAM_TOPIC_LENGTH];
+    value_t value = stream->latest;
+    int64_t half = stream->sum < 0 ? -(stream->count / 2) : (stream->count / 2);
+
+    stream_format_topic(topic, sizeof(topic), stream->kind, stream->channel);
+
+    trace_defer(stream->updated);
+    timestamp_capture(stream->updated);
+
+    usb_talk_message_start_id(&stream->id, "%s/stats", topic);
+
+    value.raw = stream->min;
+    usb_talk_message_append("{\"min\": ");
+    usb_talk_message_append_value(&value);
+
+    value.raw = stream->max;
+    usb_talk_message_append(", \"max\": ");
+    usb_talk_message_append_value(&value);
+
+    value.raw = (int32_t) ((stream->sum + half) / stream->count);
+    usb_talk_message_append(", \"mean\": ");
+    usb_talk_message_append_value(&value);
+
+    usb_talk_message_append(", \"count\": %u}", stream->count);
+
+    usb_talk_message_send();
+}
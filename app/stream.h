@@ -0,0 +1,48 @@
+#ifndef _STREAM_H
+#define _STREAM_H
+
+#include <bc_common.h>
+#include <bc_tick.h>
+#include <value.h>
+
+#define STREAM_COUNT 24
+#define STREAM_PERIOD (60 * 1000)
+#define STREAM_PERIOD_MIN (10 * 1000)
+#define STREAM_TOPIC_LENGTH 48
+
+typedef enum
+{
+    STREAM_KIND_TEMPERATURE = 0,
+    STREAM_KIND_HUMIDITY = 1,
+    STREAM_KIND_LUX_METER = 2,
+    STREAM_KIND_PRESSURE = 3,
+    STREAM_KIND_CO2 = 4,
+    STREAM_KIND_VOLTAGE = 5,
+    STREAM_KIND_COUNT = 6
+
+} stream_kind_t;
+
+void stream_init(void);
+
+// Called with the table index of every stream that got a new value or was forgotten
+void stream_set_update_handler(void (*handler)(int index, void *param), void *param);
+
+// Feeds one sample into the stream, returns false when raw values should not be forwarded
+bool stream_update(uint64_t *id, stream_kind_t kind, uint8_t channel, const value_t *value);
+
+void stream_forget(uint64_t *id);
+
+// Returns false when the index does not hold a stream
+bool stream_get(int index, uint64_t *id, stream_kind_t *kind, uint8_t *channel, value_t *latest);
+
+int stream_format_topic(char *buffer, size_t size, stream_kind_t kind, uint8_t channel);
+
+void stream_set_period(bc_tick_t period);
+
+void stream_set_raw(bool raw);
+
+void stream_publish_config(void);
+
+void stream_publish_stats(void);
+
+#endif
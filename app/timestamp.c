@@ -0,0 +1,119 @@
+#include <timestamp.h>
+#include <usb_talk.h>
+#include <bcl.h>
+
+#define TIMESTAMP_FIELD "\"tick\": "
+#define TIMESTAMP_FIELD_LENGTH (sizeof(TIMESTAMP_FIELD) - 1)
+#define TIMESTAMP_DIGITS_MAX 20
+
+static struct
+{
+    bool enabled;
+    bool synced;
+    bc_tick_t sync_tick;
+    uint32_t sync_time;
+
+    // Same scheme as the trace, the task id and spin tick tell whether the capture still belongs to this run
+    bool captured;
+    bc_scheduler_task_id_t task_id;
+    bc_tick_t spin;
+    bc_tick_t capture;
+
+} _timestamp;
+
+void timestamp_init(void)
+{
+    memset(&_timestamp, 0, sizeof(_timestamp));
+}
+
+void timestamp_set_enabled(bool enabled)
+{
+    _timestamp.enabled = enabled;
+}
+
+void timestamp_sync(uint32_t time)
+{
+    _timestamp.sync_tick = bc_tick_get();
+    _timestamp.sync_time = time;
+    _timestamp.synced = true;
+}
+
+void timestamp_capture(bc_tick_t tick)
+{
+    _timestamp.captured = true;
+    _timestamp.task_id = bc_scheduler_get_current_task_id();
+    _timestamp.spin = bc_scheduler_get_spin_tick();
+    _timestamp.capture = tick;
+}
+
+void timestamp_capture_cancel(void)
+{
+    _timestamp.captured = false;
+}
+
+bc_tick_t timestamp_get(void)
+{
+    if (_timestamp.captured && (_timestamp.task_id == bc_scheduler_get_current_task_id()) && (_timestamp.spin == bc_scheduler_get_spin_tick()))
+    {
+        return _timestamp.capture;
+    }
+
+    _timestamp.captured = false;
+
+    return bc_tick_get();
+}
+
+size_t timestamp_format(char *buffer, size_t size)
+{
+    if (!_timestamp.enabled || (size < TIMESTAMP_FIELD_LENGTH + TIMESTAMP_DIGITS_MAX + 1))
+    {
+        return 0;
+    }
+
+    char digits[TIMESTAMP_DIGITS_MAX];
+    size_t count = 0;
+    bc_tick_t tick = timestamp_get();
+
+    // Runs for every frame, so no printf
+    do
+    {
+        digits[count++] = '0' + (tick % 10);
+
+        tick /= 10;
+    }
+    while (tick != 0);
+
+    memcpy(buffer, TIMESTAMP_FIELD, TIMESTAMP_FIELD_LENGTH);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        buffer[TIMESTAMP_FIELD_LENGTH + i] = digits[count - 1 - i];
+    }
+
+    buffer[TIMESTAMP_FIELD_LENGTH + count] = '\0';
+
+    return TIMESTAMP_FIELD_LENGTH + count;
+}
+
+void timestamp_publish(void)
+{
+    bc_tick_t tick = bc_tick_get();
+
+    usb_talk_message_start("/time");
+
+    usb_talk_message_append("{\"tick\": %llu, \"stamp\": %s", (unsigned long long) tick, _timestamp.enabled ? "true" : "false");
+
+    if (_timestamp.synced)
+    {
+        bc_tick_t elapsed = tick - _timestamp.sync_tick;
+
+        // Wall clock is extrapolated from the last sync, the host can refine it from the pair
+        usb_talk_message_append(", \"time\": %lu, \"sync-tick\": %llu, \"sync-time\": %lu",
+                (unsigned long) (_timestamp.sync_time + elapsed / 1000), (unsigned long long) _timestamp.sync_tick,
+                (unsigned long) _timestamp.sync_time);
+    }
+
+    usb_talk_message_append("}");
+
+    usb_talk_message_send();
+}
@@ -0,0 +1,28 @@
+#ifndef _TIMESTAMP_H
+#define _TIMESTAMP_H
+
+#include <bc_common.h>
+#include <bc_tick.h>
+
+void timestamp_init(void);
+
+// Frames carry the gateway tick only when enabled
+void timestamp_set_enabled(bool enabled);
+
+// Pairs the current tick with the wall clock of the host, in seconds since the epoch
+void timestamp_sync(uint32_t time);
+
+// The values handled later in the same task run arrived at tick, called from the radio callbacks,
+// the sensor handlers and before publishing a value that was kept back
+void timestamp_capture(bc_tick_t tick);
+void timestamp_capture_cancel(void);
+
+// Arrival tick of the value being handled, the current tick when nothing was captured in this task run
+bc_tick_t timestamp_get(void);
+
+// Formats the tick field of the frame being written, returns zero when disabled
+size_t timestamp_format(char *buffer, size_t size);
+
+void timestamp_publish(void);
+
+#endif
@@ -0,0 +1,236 @@
+#include <trace.h>
+#include <profile.h>
+#include <usb_talk.h>
+#include <bcl.h>
+
+#if TRACE
+
+// The microsecond timer wraps after 65 ms, longer writes fall back to the tick
+#define TRACE_TIMER_RANGE 50
+
+// PROFILE=1 starts and stops the same timer around every task, a write timed inside would break it
+#define TRACE_TIMER (!PROFILE)
+
+typedef struct
+{
+    uint32_t bucket[TRACE_BUCKET_COUNT];
+    uint32_t max;
+
+} trace_histogram_t;
+
+static const char *_trace_path_names[TRACE_PATH_COUNT] = {
+    [TRACE_PATH_QUEUE] = "queue",
+    [TRACE_PATH_WRITE] = "write",
+    [TRACE_PATH_TOTAL] = "total",
+    [TRACE_PATH_STREAM] = "stream",
+    [TRACE_PATH_OUTBOX] = "outbox"
+};
+
+// Only one value is in flight at a time, the callbacks, the stream task and the write run to completion,
+// so a single set of stamps is enough. The task id and spin tick tell whether a write still belongs
+// to the last callback or deferred value or to some unrelated task.
+static struct
+{
+    bool armed;
+    bool deferred;
+    bool append;
+    bc_scheduler_task_id_t task_id;
+    bc_tick_t spin;
+    bc_tick_t entry;
+    bc_tick_t enqueue;
+    trace_histogram_t path[TRACE_PATH_COUNT];
+    bc_tick_t since;
+
+} _trace;
+
+static void _trace_arm(bc_tick_t entry, bool deferred);
+static void _trace_record(trace_path_t path, uint32_t latency);
+
+void trace_init(void)
+{
+    memset(&_trace, 0, sizeof(_trace));
+
+#if TRACE_TIMER
+    bc_timer_init();
+#endif
+}
+
+void trace_begin(void)
+{
+    _trace_arm(bc_tick_get(), false);
+}
+
+void trace_cancel(void)
+{
+    _trace.armed = false;
+}
+
+void trace_defer(bc_tick_t received)
+{
+    _trace_arm(received, true);
+}
+
+void trace_outbox(bc_tick_t queued)
+{
+    _trace_record(TRACE_PATH_OUTBOX, bc_tick_get() - queued);
+}
+
+void trace_enqueue(void)
+{
+    if (_trace.armed && ((_trace.task_id != bc_scheduler_get_current_task_id()) || (_trace.spin != bc_scheduler_get_spin_tick())))
+    {
+        _trace.armed = false;
+    }
+
+    if (!_trace.armed)
+    {
+        return;
+    }
+
+    _trace.enqueue = bc_tick_get();
+
+    _trace_record(_trace.deferred ? TRACE_PATH_STREAM : TRACE_PATH_QUEUE, _trace.enqueue - _trace.entry);
+
+#if TRACE_TIMER
+    bc_timer_start();
+#endif
+}
+
+void trace_transmit(void)
+{
+    if (!_trace.armed)
+    {
+        return;
+    }
+
+    bc_tick_t now = bc_tick_get();
+
+#if TRACE_TIMER
+    uint32_t write = bc_timer_get_microseconds();
+
+    bc_timer_stop();
+
+    if (now - _trace.enqueue > TRACE_TIMER_RANGE)
+    {
+        write = (now - _trace.enqueue) * 1000;
+    }
+#else
+    uint32_t write = now - _trace.enqueue;
+#endif
+
+    _trace_record(TRACE_PATH_WRITE, write);
+
+    if (!_trace.deferred)
+    {
+        _trace_record(TRACE_PATH_TOTAL, now - _trace.entry);
+    }
+}
+
+size_t trace_format(char *buffer, size_t size)
+{
+    if (!_trace.append || !_trace.armed)
+    {
+        return 0;
+    }
+
+    int length = snprintf(buffer, size, "\"latency\": %lu", (unsigned long) (_trace.enqueue - _trace.entry));
+
+    return (length > 0) && ((size_t) length < size) ? (size_t) length : 0;
+}
+
+void trace_set_append(bool append)
+{
+    _trace.append = append;
+}
+
+void trace_reset(void)
+{
+    memset(_trace.path, 0, sizeof(_trace.path));
+
+    _trace.since = bc_tick_get();
+}
+
+void trace_publish(void)
+{
+    usb_talk_message_start("/trace");
+
+    usb_talk_message_append("{\"period\": %lu, \"append\": %s, \"buckets\": [0",
+            (unsigned long) (bc_tick_get() - _trace.since), _trace.append ? "true" : "false");
+
+    for (int j = 1; j < TRACE_BUCKET_COUNT; j++)
+    {
+        usb_talk_message_append(", %lu", 1UL << (j - 1));
+    }
+
+    usb_talk_message_append("]");
+
+    for (int i = 0; i < TRACE_PATH_COUNT; i++)
+    {
+        trace_histogram_t *histogram = &_trace.path[i];
+        const char *unit = (i == TRACE_PATH_WRITE) && TRACE_TIMER ? "us" : "ms";
+
+        usb_talk_message_append(", \"%s\": {\"unit\": \"%s\", \"max\": %lu, \"counts\": [",
+                _trace_path_names[i], unit, (unsigned long) histogram->max);
+
+        for (int j = 0; j < TRACE_BUCKET_COUNT; j++)
+        {
+            usb_talk_message_append(j == 0 ? "%lu" : ", %lu", (unsigned long) histogram->bucket[j]);
+        }
+
+        usb_talk_message_append("]}");
+    }
+
+    usb_talk_message_append("}");
+
+    usb_talk_message_send();
+}
+
+static void _trace_arm(bc_tick_t entry, bool deferred)
+{
+    _trace.armed = true;
+    _trace.deferred = deferred;
+    _trace.task_id = bc_scheduler_get_current_task_id();
+    _trace.spin = bc_scheduler_get_spin_tick();
+    _trace.entry = entry;
+}
+
+static void _trace_record(trace_path_t path, uint32_t latency)
+{
+    trace_histogram_t *histogram = &_trace.path[path];
+    int bucket = 0;
+
+    // Power of two buckets in the unit of the path, the last one is open ended
+    while ((bucket < TRACE_BUCKET_COUNT - 1) && (latency >= ((uint32_t) 1 << bucket)))
+    {
+        bucket++;
+    }
+
+    histogram->bucket[bucket]++;
+
+    if (latency > histogram->max)
+    {
+        histogram->max = latency;
+    }
+}
+
+#else
+
+void trace_init(void)
+{
+}
+
+void trace_set_append(bool append)
+{
+    (void) append;
+}
+
+void trace_reset(void)
+{
+}
+
+void trace_publish(void)
+{
+    usb_talk_send_string("[\"/trace\", null]\n");
+}
+
+#endif
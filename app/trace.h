@@ -0,0 +1,63 @@
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <bc_common.h>
+#include <bc_tick.h>
+
+// Build with TRACE=1 to measure how long radio values stay in the gateway
+#ifndef TRACE
+#define TRACE 0
+#endif
+
+#define TRACE_BUCKET_COUNT 12
+
+// Queue and total run from the radio callback, stream from the arrival of the last value of a window
+// to its frame and outbox from the host command to the radio, all in milliseconds.
+// Write is the transport write of a frame in microseconds, in milliseconds when PROFILE=1 owns the timer.
+typedef enum
+{
+    TRACE_PATH_QUEUE = 0,
+    TRACE_PATH_WRITE = 1,
+    TRACE_PATH_TOTAL = 2,
+    TRACE_PATH_STREAM = 3,
+    TRACE_PATH_OUTBOX = 4,
+    TRACE_PATH_COUNT = 5
+
+} trace_path_t;
+
+#if TRACE
+// Radio callback entry, frames written later in the same task run are measured against it
+void trace_begin(void);
+void trace_cancel(void);
+
+// Before writing a frame with a value that arrived at received and was kept back
+void trace_defer(bc_tick_t received);
+
+// An outbox entry queued at queued has just been handed to the radio
+void trace_outbox(bc_tick_t queued);
+
+// Around the transport write of every frame
+void trace_enqueue(void);
+void trace_transmit(void);
+
+// Formats the latency of the frame being written, returns zero when there is nothing to append
+size_t trace_format(char *buffer, size_t size);
+#else
+#define trace_begin() ((void) 0)
+#define trace_cancel() ((void) 0)
+#define trace_defer(received) ((void) 0)
+#define trace_outbox(queued) ((void) 0)
+#define trace_enqueue() ((void) 0)
+#define trace_transmit() ((void) 0)
+#define trace_format(buffer, size) ((size_t) 0)
+#endif
+
+void trace_init(void);
+
+void trace_set_append(bool append);
+
+void trace_reset(void);
+
+void trace_publish(void);
+
+#endif
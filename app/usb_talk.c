@@ -4,6 +4,13 @@
 #include <bc_radio_pub.h>
 #include <base64.h>
 #include <application.h>
+#include <group.h>
+#include <outbox.h>
+#include <alias.h>
+#include <profile.h>
+#include <trace.h>
+#include <timestamp.h>
+#include <activity.h>
 
 #define USB_TALK_MAX_TOKENS 100
 
@@ -13,6 +20,12 @@
 #define USB_TALK_TOKEN_PAYLOAD_KEY   3
 #define USB_TALK_TOKEN_PAYLOAD_VALUE 4
 
+#define USB_TALK_MESSAGE_END_LENGTH 3
+#define USB_TALK_META_LENGTH 72
+
+#define USB_TALK_GROUP_PREFIX "group/"
+#define USB_TALK_GROUP_PREFIX_LENGTH 6
+
 static struct
 {
     char tx_buffer[512];
@@ -20,6 +33,9 @@ static struct
     size_t rx_length;
     size_t tx_length;
     bool rx_error;
+    usb_talk_stats_t stats;
+    bool alias_topics;
+    char node[ALIAS_NAME_LENGTH + 1];
 
     const usb_talk_subscribe_t *subscribes;
     int subscribes_length;
@@ -39,8 +55,15 @@ static void _usb_talk_cdc_read_task(void *param);
 #else
 static void _usb_talk_uart_event_handler(bc_uart_channel_t channel, bc_uart_event_t event, void  *event_param);
 #endif
+static void _usb_talk_publish_node_list(const uint64_t *peer_devices_address, int length);
+static void _usb_talk_message_flush(void);
+static void _usb_talk_write(const char *buffer, size_t length);
+static bool _usb_talk_transport_write(const char *buffer, size_t length);
+static size_t _usb_talk_meta_format(char *buffer, size_t size);
 static void _usb_talk_process_character(char character);
 static void _usb_talk_process_message(char *message, size_t length);
+static void _usb_talk_dispatch(uint64_t *device_address, const char *topic, size_t topic_length, usb_talk_payload_t *payload);
+static const char *_usb_talk_node(uint64_t *device_address);
 static bool _usb_talk_token_get_int(const char *buffer, jsmntok_t *token, int *value);
 static bool _usb_talk_token_get_float(const char *buffer, jsmntok_t *token, float *value);
 static bool _usb_talk_token_get_string(const char *buffer, jsmntok_t *token, char *str, size_t *length);
@@ -68,7 +91,7 @@ void usb_talk_subscribes(const usb_talk_subscribe_t *subscribes, int length)
     if ((subscribes != NULL) && length > 0)
     {
 #if TALK_OVER_CDC
-        bc_scheduler_register(_usb_talk_cdc_read_task, NULL, 0);
+        PROFILE_REGISTER(_usb_talk_cdc_read_task, NULL, 0);
 #else
         bc_uart_set_event_handler(BC_UART_UART2, _usb_talk_uart_event_handler, NULL);
         bc_uart_async_read_start(BC_UART_UART2, 1000000);
@@ -78,11 +101,7 @@ void usb_talk_subscribes(const usb_talk_subscribe_t *subscribes, int length)
 
 void usb_talk_send_string(const char *buffer)
 {
-#if TALK_OVER_CDC
-    bc_usb_cdc_write(buffer, strlen(buffer));
-#else
-    bc_uart_async_write(BC_UART_UART2, buffer, strlen(buffer));
-#endif
+    _usb_talk_write(buffer, strlen(buffer));
 }
 
 void usb_talk_send_format(const char *format, ...)
@@ -94,14 +113,25 @@ void usb_talk_send_format(const char *format, ...)
     length = vsnprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer), format, ap);
     va_end(ap);
 
-#if TALK_OVER_CDC
-    bc_usb_cdc_write(_usb_talk.tx_buffer, length);
-#else
-    bc_uart_async_write(BC_UART_UART2, _usb_talk.tx_buffer, length);
-#endif
+    _usb_talk_write(_usb_talk.tx_buffer, length);
 }
 
 
+const usb_talk_stats_t *usb_talk_get_stats(void)
+{
+    return &_usb_talk.stats;
+}
+
+void usb_talk_set_alias_topics(bool enabled)
+{
+    _usb_talk.alias_topics = enabled;
+}
+
+bool usb_talk_get_alias_topics(void)
+{
+    return _usb_talk.alias_topics;
+}
+
 void usb_talk_message_start(const char *topic, ...)
 {
     va_list ap;
@@ -125,9 +155,7 @@ void usb_talk_message_start_id(uint64_t *device_address, const char *topic, ...)
 
     strcpy(_usb_talk.tx_buffer, "[\"");
 
-    _usb_talk.tx_length = 2 + snprintf(_usb_talk.tx_buffer + 2, sizeof(_usb_talk.tx_buffer) - 2, USB_TALK_DEVICE_ADDRESS, *device_address);
-
-    _usb_talk.tx_buffer[_usb_talk.tx_length++] = '/';
+    _usb_talk.tx_length = 2 + snprintf(_usb_talk.tx_buffer + 2, sizeof(_usb_talk.tx_buffer) - 2, "%s/", _usb_talk_node(device_address));
 
     va_start(ap, topic);
 
@@ -143,12 +171,38 @@ void usb_talk_message_start_id(uint64_t *device_address, const char *topic, ...)
 void usb_talk_message_append(const char *format, ...)
 {
     va_list ap;
+    size_t space = sizeof(_usb_talk.tx_buffer) - USB_TALK_MESSAGE_END_LENGTH - _usb_talk.tx_length;
 
     va_start(ap, format);
 
-    _usb_talk.tx_length += vsnprintf(_usb_talk.tx_buffer + _usb_talk.tx_length, sizeof(_usb_talk.tx_buffer) - _usb_talk.tx_length, format, ap);
+    size_t length = vsnprintf(_usb_talk.tx_buffer + _usb_talk.tx_length, space, format, ap);
 
     va_end(ap);
+
+    if ((length >= space) && (_usb_talk.tx_length > 0))
+    {
+        // The message does not fit into the TX buffer, send what we have and continue on the same line
+        _usb_talk_message_flush();
+
+        space = sizeof(_usb_talk.tx_buffer) - USB_TALK_MESSAGE_END_LENGTH;
+
+        va_start(ap, format);
+
+        length = vsnprintf(_usb_talk.tx_buffer, space, format, ap);
+
+        va_end(ap);
+    }
+
+    _usb_talk.tx_length += length < space ? length : space - 1;
+}
+
+void usb_talk_message_append_value(const value_t *value)
+{
+    char buffer[VALUE_FORMAT_LENGTH];
+
+    value_format(buffer, sizeof(buffer), value);
+
+    usb_talk_message_append("%s", buffer);
 }
 
 void usb_talk_message_send(void)
@@ -157,16 +211,12 @@ void usb_talk_message_send(void)
 
     _usb_talk.tx_length += 2;
 
-#if TALK_OVER_CDC
-    bc_usb_cdc_write(_usb_talk.tx_buffer, _usb_talk.tx_length);
-#else
-    bc_uart_async_write(BC_UART_UART2, _usb_talk.tx_buffer, _usb_talk.tx_length);
-#endif
+    _usb_talk_write(_usb_talk.tx_buffer, _usb_talk.tx_length);
 }
 
 void usb_talk_publish_null(uint64_t *device_address, const char *subtopics)
 {
-    usb_talk_send_format("[\"%012llx/%s\", null]\n", *device_address, subtopics);
+    usb_talk_send_format("[\"%s/%s\", null]\n", _usb_talk_node(device_address), subtopics);
 }
 
 void usb_talk_publish_bool(uint64_t *device_address, const char *subtopics, bool *value)
@@ -178,7 +228,7 @@ void usb_talk_publish_bool(uint64_t *device_address, const char *subtopics, bool
         return;
     }
 
-    usb_talk_send_format("[\"%012llx/%s\", %s]\n", *device_address, subtopics, *value ? "true" : "false");
+    usb_talk_send_format("[\"%s/%s\", %s]\n", _usb_talk_node(device_address), subtopics, *value ? "true" : "false");
 }
 
 void usb_talk_publish_int(uint64_t *device_address, const char *subtopics, int *value)
@@ -190,7 +240,7 @@ void usb_talk_publish_int(uint64_t *device_address, const char *subtopics, int *
         return;
     }
 
-    usb_talk_send_format("[\"%012llx/%s\", %d]\n", *device_address, subtopics, *value);
+    usb_talk_send_format("[\"%s/%s\", %d]\n", _usb_talk_node(device_address), subtopics, *value);
 }
 
 void usb_talk_publish_float(uint64_t *device_address, const char *subtopics, float *value)
@@ -202,14 +252,14 @@ void usb_talk_publish_float(uint64_t *device_address, const char *subtopics, flo
         return;
     }
 
-    usb_talk_send_format("[\"%012llx/%s\", %0.2f]\n", *device_address, subtopics, *value);
+    usb_talk_send_format("[\"%s/%s\", %0.2f]\n", _usb_talk_node(device_address), subtopics, *value);
 }
 
 void usb_talk_publish_complex_bool(uint64_t *device_address, const char *subtopic, const char *number, const char *name, bool *state)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/%s/%s/%s\", %s]\n",
-                *device_address, subtopic, number, name, *state ? "true" : "false");
+                "[\"%s/%s/%s/%s\", %s]\n",
+                _usb_talk_node(device_address), subtopic, number, name, *state ? "true" : "false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
@@ -217,8 +267,8 @@ void usb_talk_publish_complex_bool(uint64_t *device_address, const char *subtopi
 void usb_talk_publish_event_count(uint64_t *device_address, const char *name, uint16_t *event_count)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-             "[\"%012llx/%s/event-count\", %" PRIu16 "]\n",
-             *device_address, name, *event_count);
+             "[\"%s/%s/event-count\", %" PRIu16 "]\n",
+             _usb_talk_node(device_address), name, *event_count);
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
@@ -226,89 +276,92 @@ void usb_talk_publish_event_count(uint64_t *device_address, const char *name, ui
 void usb_talk_publish_led(uint64_t *device_address, bool *state)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/led/-/state\", %s]\n",
-                *device_address, *state ? "true" : "false");
+                "[\"%s/led/-/state\", %s]\n",
+                _usb_talk_node(device_address), *state ? "true" : "false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
 
-void usb_talk_publish_temperature(uint64_t *device_address, uint8_t channel, float *celsius)
+void usb_talk_publish_temperature(uint64_t *device_address, uint8_t channel, const value_t *celsius)
 {
-    if(channel == BC_RADIO_PUB_CHANNEL_A)
+    if (channel == BC_RADIO_PUB_CHANNEL_A)
     {
-        snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/thermometer/a/temperature\", %0.2f]\n",
-                *device_address, *celsius);
+        usb_talk_message_start_id(device_address, "thermometer/a/temperature");
     }
     else if (channel == BC_RADIO_PUB_CHANNEL_B)
     {
-        snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/thermometer/b/temperature\", %0.2f]\n",
-                *device_address, *celsius);
+        usb_talk_message_start_id(device_address, "thermometer/b/temperature");
     }
     else if (channel == BC_RADIO_PUB_CHANNEL_SET_POINT)
     {
-        snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                        "[\"%012llx/thermometer/set-point/temperature\", %0.2f]\n",
-                        *device_address, *celsius);
+        usb_talk_message_start_id(device_address, "thermometer/set-point/temperature");
     }
     else
     {
-        snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/thermometer/%d:%d/temperature\", %0.2f]\n",
-                *device_address, ((channel & 0x80) >> 7), (channel & ~0x80), *celsius);
+        usb_talk_message_start_id(device_address, "thermometer/%d:%d/temperature", ((channel & 0x80) >> 7), (channel & ~0x80));
     }
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    usb_talk_message_append_value(celsius);
+
+    usb_talk_message_send();
 }
 
-void usb_talk_publish_humidity(uint64_t *device_address, uint8_t channel, float *relative_humidity)
+void usb_talk_publish_humidity(uint64_t *device_address, uint8_t channel, const value_t *relative_humidity)
 {
-    snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/hygrometer/%d:%d/relative-humidity\", %0.1f]\n",
-                *device_address, ((channel & 0x80) >> 7), (channel & ~0x80), *relative_humidity);
+    usb_talk_message_start_id(device_address, "hygrometer/%d:%d/relative-humidity", ((channel & 0x80) >> 7), (channel & ~0x80));
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    usb_talk_message_append_value(relative_humidity);
+
+    usb_talk_message_send();
 }
 
-void usb_talk_publish_lux_meter(uint64_t *device_address, uint8_t channel, float *illuminance)
+void usb_talk_publish_lux_meter(uint64_t *device_address, uint8_t channel, const value_t *illuminance)
 {
-    snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/lux-meter/%d:%d/illuminance\", %0.1f]\n",
-                *device_address,  ((channel & 0x80) >> 7), (channel & ~0x80), *illuminance);
+    usb_talk_message_start_id(device_address, "lux-meter/%d:%d/illuminance", ((channel & 0x80) >> 7), (channel & ~0x80));
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    usb_talk_message_append_value(illuminance);
+
+    usb_talk_message_send();
 }
 
-void usb_talk_publish_barometer(uint64_t *device_address, uint8_t channel, float *pressure, float *altitude)
+void usb_talk_publish_barometer(uint64_t *device_address, uint8_t channel, const value_t *pressure, const value_t *altitude)
 {
-    snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/barometer/%d:%d/pressure\", %0.2f]\n",
-                *device_address,  ((channel & 0x80) >> 7), (channel & ~0x80), *pressure);
+    usb_talk_message_start_id(device_address, "barometer/%d:%d/pressure", ((channel & 0x80) >> 7), (channel & ~0x80));
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    usb_talk_message_append_value(pressure);
 
-    snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/barometer/%d:%d/altitude\", %0.2f]\n",
-                *device_address,  ((channel & 0x80) >> 7), (channel & ~0x80), *altitude);
+    usb_talk_message_send();
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    usb_talk_message_start_id(device_address, "barometer/%d:%d/altitude", ((channel & 0x80) >> 7), (channel & ~0x80));
+
+    usb_talk_message_append_value(altitude);
+
+    usb_talk_message_send();
 }
 
-void usb_talk_publish_co2(uint64_t *device_address, float *concentration)
+void usb_talk_publish_co2(uint64_t *device_address, const value_t *concentration)
 {
-    snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/co2-meter/-/concentration\", %.0f]\n",
-                *device_address, *concentration);
+    usb_talk_message_start_id(device_address, "co2-meter/-/concentration");
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    usb_talk_message_append_value(concentration);
+
+    usb_talk_message_send();
+}
+
+void usb_talk_publish_battery(uint64_t *device_address, const value_t *voltage)
+{
+    usb_talk_message_start_id(device_address, "battery/-/voltage");
+
+    usb_talk_message_append_value(voltage);
+
+    usb_talk_message_send();
 }
 
 void usb_talk_publish_light(uint64_t *device_address, bool *state)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/light/-/state\", %s]\n",
-                *device_address, *state ? "true" : "false");
+                "[\"%s/light/-/state\", %s]\n",
+                _usb_talk_node(device_address), *state ? "true" : "false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
@@ -316,8 +369,8 @@ void usb_talk_publish_light(uint64_t *device_address, bool *state)
 void usb_talk_publish_relay(uint64_t *device_address, bool *state)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                "[\"%012llx/relay/-/state\", %s]\n",
-                *device_address, *state ? "true" : "false");
+                "[\"%s/relay/-/state\", %s]\n",
+                _usb_talk_node(device_address), *state ? "true" : "false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
@@ -327,14 +380,14 @@ void usb_talk_publish_module_relay(uint64_t *device_address, uint8_t *number, bc
     if (*state == BC_MODULE_RELAY_STATE_UNKNOWN)
     {
         snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                    "[\"%012llx/relay/0:%d/state\", null]\n",
-                    *device_address, *number);
+                    "[\"%s/relay/0:%d/state\", null]\n",
+                    _usb_talk_node(device_address), *number);
     }
     else
     {
         snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                    "[\"%012llx/relay/0:%d/state\", %s]\n",
-                    *device_address, *number, *state == BC_MODULE_RELAY_STATE_TRUE ? "true" : "false");
+                    "[\"%s/relay/0:%d/state\", %s]\n",
+                    _usb_talk_node(device_address), *number, *state == BC_MODULE_RELAY_STATE_TRUE ? "true" : "false");
     }
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
@@ -343,8 +396,8 @@ void usb_talk_publish_module_relay(uint64_t *device_address, uint8_t *number, bc
 void usb_talk_publish_encoder(uint64_t *device_address, int *increment)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-             "[\"%012llx/encoder/-/increment\", %d]\n",
-             *device_address, *increment);
+             "[\"%s/encoder/-/increment\", %d]\n",
+             _usb_talk_node(device_address), *increment);
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
@@ -352,8 +405,8 @@ void usb_talk_publish_encoder(uint64_t *device_address, int *increment)
 void usb_talk_publish_flood_detector(uint64_t *device_address, const char *number, bool *state)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-             "[\"%012llx/flood-detector/%c/alarm\", %s]\n",
-             *device_address, *number, *state ? "true" : "false");
+             "[\"%s/flood-detector/%c/alarm\", %s]\n",
+             _usb_talk_node(device_address), *number, *state ? "true" : "false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
@@ -361,34 +414,145 @@ void usb_talk_publish_flood_detector(uint64_t *device_address, const char *numbe
 void usb_talk_publish_accelerometer_acceleration(uint64_t *device_address, float *x_axis, float *y_axis, float *z_axis)
 {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-            "[\"%012llx/accelerometer/-/acceleration\", [%0.2f,%0.2f,%0.2f]]\n",
-            *device_address, *x_axis, *y_axis, *z_axis);
+            "[\"%s/accelerometer/-/acceleration\", [%0.2f,%0.2f,%0.2f]]\n",
+            _usb_talk_node(device_address), *x_axis, *y_axis, *z_axis);
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
 
-void usb_talk_publish_nodes(uint64_t *peer_devices_address, int lenght)
+void usb_talk_publish_nodes(const uint64_t *peer_devices_address, int length)
+{
+    usb_talk_message_start("/nodes");
+
+    _usb_talk_publish_node_list(peer_devices_address, length);
+
+    usb_talk_message_send();
+}
+
+void usb_talk_publish_nodes_page(const uint64_t *peer_devices_address, int length, int page, int pages)
+{
+    usb_talk_message_start("/nodes/page");
+
+    usb_talk_message_append("{\"page\": %d, \"pages\": %d, \"nodes\": ", page, pages);
+
+    _usb_talk_publish_node_list(peer_devices_address, length);
+
+    usb_talk_message_append("}");
+
+    usb_talk_message_send();
+}
+
+static void _usb_talk_publish_node_list(const uint64_t *peer_devices_address, int length)
+{
+    usb_talk_message_append("[");
+
+    for (int i = 0; i < length; i++)
+    {
+        usb_talk_message_append(i == 0 ? "\"" USB_TALK_DEVICE_ADDRESS "\"" : ",\"" USB_TALK_DEVICE_ADDRESS "\"", peer_devices_address[i]);
+    }
+
+    usb_talk_message_append("]");
+}
+
+static void _usb_talk_message_flush(void)
+{
+    _usb_talk_write(_usb_talk.tx_buffer, _usb_talk.tx_length);
+
+    _usb_talk.tx_length = 0;
+}
+
+static void _usb_talk_write(const char *buffer, size_t length)
+{
+    char meta[USB_TALK_META_LENGTH];
+    size_t meta_length = 0;
+    bool written;
+
+    // Flushed parts of a long message do not end the frame
+    bool frame = (length >= 2) && (buffer[length - 2] == ']') && (buffer[length - 1] == '\n');
+
+    activity_signal(ACTIVITY_TX);
+
+    // Optional metadata goes in as a third array element
+    if (frame)
+    {
+        trace_enqueue();
+
+        meta_length = _usb_talk_meta_format(meta, sizeof(meta));
+    }
+
+    if (meta_length != 0)
+    {
+        written = _usb_talk_transport_write(buffer, length - 2) && _usb_talk_transport_write(meta, meta_length);
+
+        length += meta_length - 2;
+    }
+    else
+    {
+        written = _usb_talk_transport_write(buffer, length);
+    }
+
+    if (frame)
+    {
+        trace_transmit();
+
+        _usb_talk.stats.tx_messages++;
+    }
+
+    if (written)
+    {
+        _usb_talk.stats.tx_bytes += length;
+    }
+    else
+    {
+        _usb_talk.stats.tx_drops++;
+    }
+}
+
+static bool _usb_talk_transport_write(const char *buffer, size_t length)
 {
-    int offset = snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-                 "[\"/nodes\", [" );
-    bool empty = true;
-    for (int i = 0; i < lenght; i++)
+#if TALK_OVER_CDC
+    return bc_usb_cdc_write(buffer, length);
+#else
+    return bc_uart_async_write(BC_UART_UART2, buffer, length) == length;
+#endif
+}
+
+static size_t _usb_talk_meta_format(char *buffer, size_t size)
+{
+    static const char head[] = ", {";
+    static const char tail[] = "}]\n";
+    size_t length = sizeof(head) - 1;
+
+    // Fields go after the head, the room for the tail is kept aside
+    size -= sizeof(tail);
+
+    length += timestamp_format(buffer + length, size - length);
+
+    if (length == sizeof(head) - 1)
+    {
+        length += trace_format(buffer + length, size - length);
+    }
+    else if (size - length > 2)
     {
-        if (peer_devices_address[i] == 0)
+        size_t field = trace_format(buffer + length + 2, size - length - 2);
+
+        if (field != 0)
         {
-            continue;
-        }
+            memcpy(buffer + length, ", ", 2);
 
-        offset += snprintf(_usb_talk.tx_buffer + offset, sizeof(_usb_talk.tx_buffer) - offset,
-                empty ? "\"%012llx\"" : ",\"%012llx\"",
-                peer_devices_address[i]);
+            length += field + 2;
+        }
+    }
 
-        empty = false;
+    if (length == sizeof(head) - 1)
+    {
+        return 0;
     }
 
-    strncpy(_usb_talk.tx_buffer + offset, "]]\n", sizeof(_usb_talk.tx_buffer) - offset);
+    memcpy(buffer, head, sizeof(head) - 1);
+    memcpy(buffer + length, tail, sizeof(tail));
 
-    usb_talk_send_string((const char *) _usb_talk.tx_buffer);
+    return length + sizeof(tail) - 1;
 }
 
 #if TALK_OVER_CDC
@@ -446,10 +610,14 @@ static void _usb_talk_uart_event_handler(bc_uart_channel_t channel, bc_uart_even
 
 static void _usb_talk_process_character(char character)
 {
+    _usb_talk.stats.rx_bytes++;
+
     if (character == '\n')
     {
         if (!_usb_talk.rx_error && _usb_talk.rx_length > 0)
         {
+            _usb_talk.stats.rx_messages++;
+
             _usb_talk_process_message(_usb_talk.rx_buffer, _usb_talk.rx_length);
         }
 
@@ -461,6 +629,13 @@ static void _usb_talk_process_character(char character)
 
     if (_usb_talk.rx_length == sizeof(_usb_talk.rx_buffer))
     {
+        if (!_usb_talk.rx_error)
+        {
+            _usb_talk.stats.rx_overflow++;
+
+            activity_signal(ACTIVITY_ERROR);
+        }
+
         _usb_talk.rx_error = true;
     }
     else
@@ -483,16 +658,28 @@ static void _usb_talk_process_message(char *message, size_t length)
 
     if (token_count < 3)
     {
+        _usb_talk.stats.rx_json++;
+
+        activity_signal(ACTIVITY_ERROR);
+
         return;
     }
 
     if (tokens[USB_TALK_TOKEN_ARRAY].type != JSMN_ARRAY || tokens[USB_TALK_TOKEN_ARRAY].size != 2)
     {
+        _usb_talk.stats.rx_format++;
+
+        activity_signal(ACTIVITY_ERROR);
+
         return;
     }
 
     if (tokens[USB_TALK_TOKEN_TOPIC].type != JSMN_STRING || tokens[USB_TALK_TOKEN_TOPIC].size != 0)
     {
+        _usb_talk.stats.rx_format++;
+
+        activity_signal(ACTIVITY_ERROR);
+
         return;
     }
 
@@ -502,33 +689,116 @@ static void _usb_talk_process_message(char *message, size_t length)
 
     uint64_t device_address = 0;
 
+    usb_talk_payload_t payload = {
+            message,
+            token_count - USB_TALK_TOKEN_PAYLOAD,
+            tokens + USB_TALK_TOKEN_PAYLOAD
+    };
+
+    if ((topic_length > USB_TALK_GROUP_PREFIX_LENGTH) && (strncmp(topic, USB_TALK_GROUP_PREFIX, USB_TALK_GROUP_PREFIX_LENGTH) == 0))
+    {
+        char *name = topic + USB_TALK_GROUP_PREFIX_LENGTH;
+        char *end = memchr(name, '/', topic_length - USB_TALK_GROUP_PREFIX_LENGTH);
+
+        if (end == NULL)
+        {
+            _usb_talk.stats.rx_address++;
+
+            return;
+        }
+
+        int group = group_find(name, end - name);
+
+        if (group < 0)
+        {
+            _usb_talk.stats.rx_address++;
+
+            return;
+        }
+
+        topic_length -= end + 1 - topic;
+        topic = end + 1;
+
+        // Expand the command to every member as if the host sent it to each of them,
+        // with GROUP_BROADCAST state commands for listening members leave in a single broadcast
+        outbox_group_begin(group);
+
+        for (int i = 0; group_get_member(group, i, &device_address); i++)
+        {
+            outbox_group_member(i);
+
+            _usb_talk_dispatch(&device_address, topic, topic_length, &payload);
+        }
+
+        uint32_t missed = outbox_group_end();
+
+        for (int i = 0; (missed != 0) && group_get_member(group, i, &device_address); i++)
+        {
+            if (missed & ((uint32_t) 1 << i))
+            {
+                _usb_talk_dispatch(&device_address, topic, topic_length, &payload);
+            }
+        }
+
+        return;
+    }
+
     if ((topic[0] != '$') && (topic[0] != '/'))
     {
-        if (topic_length < 14)
+        char *end = memchr(topic, '/', topic_length);
+
+        if ((end == NULL) || (end + 1 == topic + topic_length))
         {
+            _usb_talk.stats.rx_address++;
             return;
         }
-        if(topic[12] != '/')
+
+        // Hex id first, a name of the same length that is not a valid id falls through to the aliases
+        if ((end - topic == 12) && (strspn(topic, "0123456789abcdefABCDEF") == 12))
+        {
+            sscanf(topic, USB_TALK_DEVICE_ADDRESS_SCAN "/", &device_address);
+        }
+        else if (!alias_find(topic, end - topic, &device_address))
         {
+            _usb_talk.stats.rx_address++;
             return;
         }
-        sscanf(topic, "%012llx/", &device_address);
-        topic += 13;
-        topic_length -= 13;
+
+        topic_length -= end + 1 - topic;
+        topic = end + 1;
+    }
+
+    _usb_talk_dispatch(&device_address, topic, topic_length, &payload);
+}
+
+static const char *_usb_talk_node(uint64_t *device_address)
+{
+    if (!_usb_talk.alias_topics || !alias_get(device_address, _usb_talk.node, sizeof(_usb_talk.node)))
+    {
+        snprintf(_usb_talk.node, sizeof(_usb_talk.node), USB_TALK_DEVICE_ADDRESS, *device_address);
     }
 
+    return _usb_talk.node;
+}
+
+static void _usb_talk_dispatch(uint64_t *device_address, const char *topic, size_t topic_length, usb_talk_payload_t *payload)
+{
+    bool matched = false;
+
     for (int i = 0; i < _usb_talk.subscribes_length; i++)
     {
         if (strncmp(_usb_talk.subscribes[i].topic, topic, topic_length) == 0)
         {
-            usb_talk_payload_t payload = {
-                    message,
-                    token_count - USB_TALK_TOKEN_PAYLOAD,
-                    tokens + USB_TALK_TOKEN_PAYLOAD
-            };
-            _usb_talk.subscribes[i].callback(&device_address, &payload, (usb_talk_subscribe_t *) &_usb_talk.subscribes[i]);
+            _usb_talk.subscribes[i].callback(device_address, payload, (usb_talk_subscribe_t *) &_usb_talk.subscribes[i]);
+
+            matched = true;
         }
     }
+
+    if (!matched)
+    {
+        _usb_talk.stats.dispatch_miss++;
+    }
 }
 
 bool usb_talk_payload_get_bool(usb_talk_payload_t *payload, bool *value)
@@ -839,30 +1109,38 @@ bool usb_talk_payload_get_compound(usb_talk_payload_t *payload, uint8_t *compoun
     }
 
     int count;
+    uint32_t color;
     size_t _length = 0;
     *count_sum = 0;
 
-    for (int i = 1; (i + 1 < payload->token_count) && (_length + 5 <= *length); i += 2)
+    for (int i = 1; i + 1 < payload->token_count; i += 2)
     {
         if (!_usb_talk_token_get_int(payload->buffer, &payload->tokens[i], &count))
         {
             return false;
         }
 
-        if (count > 255)
+        if (!_usb_talk_payload_get_color(payload->buffer, &payload->tokens[i + 1], &color))
         {
-            count = 255;
+            return false;
         }
 
-        compound[_length++] = count;
         *count_sum += count;
 
-        if (!_usb_talk_payload_get_color(payload->buffer, &payload->tokens[i + 1], (uint32_t *) (compound + _length)))
+        // Counts above 255 take more tuples of the same color
+        while (count > 0)
         {
-            return false;
-        }
+            if (_length + 5 > *length)
+            {
+                return false;
+            }
+
+            compound[_length] = count > 255 ? 255 : count;
+            memcpy(compound + _length + 1, &color, sizeof(color));
 
-        _length += 4;
+            count -= compound[_length];
+            _length += 5;
+        }
     }
 
     *length = _length;
@@ -987,7 +1265,7 @@ static bool _usb_talk_payload_get_node_id(const char *buffer, jsmntok_t *token,
 
     str_id[12] = 0;
 
-    sscanf(str_id, USB_TALK_DEVICE_ADDRESS, value);
+    sscanf(str_id, USB_TALK_DEVICE_ADDRESS_SCAN, value);
 
     return true;
 }
@@ -1031,24 +1309,24 @@ static bool _usb_talk_payload_get_color(const char *buffer, jsmntok_t *token, ui
 
 void usb_talk_publish_watering_humidity(uint64_t *device_address, uint8_t humidity) {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-            "[\"%012llx/watering/-/humidity\", %d]\n",
-            *device_address, humidity);
+            "[\"%s/watering/-/humidity\", %d]\n",
+            _usb_talk_node(device_address), humidity);
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
 
 void usb_talk_publish_watering_pump(uint64_t *device_address, uint8_t watering_pump) {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-            "[\"%012llx/watering/-/pump\", %s]\n",
-            *device_address, watering_pump?"true":"false");
+            "[\"%s/watering/-/pump\", %s]\n",
+            _usb_talk_node(device_address), watering_pump?"true":"false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);    
 }
 
 void usb_talk_publish_watering_water_level(uint64_t *device_address, uint8_t watering_water_level) {
     snprintf(_usb_talk.tx_buffer, sizeof(_usb_talk.tx_buffer),
-            "[\"%012llx/watering/-/water-level\", %s]\n",
-            *device_address, watering_water_level?"true":"false");
+            "[\"%s/watering/-/water-level\", %s]\n",
+            _usb_talk_node(device_address), watering_water_level?"true":"false");
 
     usb_talk_send_string((const char *) _usb_talk.tx_buffer);
 }
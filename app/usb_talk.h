@@ -4,9 +4,13 @@
 #include <bc_common.h>
 #include <jsmn.h>
 #include <bc_module_relay.h>
+#include <value.h>
+#include <inttypes.h>
 
 #define USB_TALK_INT_VALUE_NULL INT32_MIN
-#define USB_TALK_DEVICE_ADDRESS "%012llx"
+#define USB_TALK_DEVICE_ADDRESS "%012" PRIx64
+#define USB_TALK_DEVICE_ADDRESS_SCAN "%012" SCNx64
+#define USB_TALK_FORMAT(string, first) __attribute__((format(printf, string, first)))
 
 typedef struct
 {
@@ -20,6 +24,21 @@ typedef struct usb_talk_subscribe_t usb_talk_subscribe_t;
 
 typedef void (*usb_talk_sub_callback_t)(uint64_t *device_address, usb_talk_payload_t *payload, usb_talk_subscribe_t *sub);
 
+typedef struct
+{
+    uint32_t rx_messages;
+    uint32_t rx_bytes;
+    uint32_t rx_overflow;
+    uint32_t rx_json;
+    uint32_t rx_format;
+    uint32_t rx_address;
+    uint32_t dispatch_miss;
+    uint32_t tx_messages;
+    uint32_t tx_bytes;
+    uint32_t tx_drops;
+
+} usb_talk_stats_t;
+
 struct usb_talk_subscribe_t
 {
     const char *topic;
@@ -31,10 +50,17 @@ struct usb_talk_subscribe_t
 void usb_talk_init(void);
 void usb_talk_subscribes(const usb_talk_subscribe_t *subscribes, int length);
 void usb_talk_send_string(const char *buffer);
-void usb_talk_send_format(const char *format, ...);
+void usb_talk_send_format(const char *format, ...) USB_TALK_FORMAT(1, 2);
+const usb_talk_stats_t *usb_talk_get_stats(void);
+
+// Node topics start with the alias of the node when it has one, commands are accepted both ways
+void usb_talk_set_alias_topics(bool enabled);
+bool usb_talk_get_alias_topics(void);
 
-void usb_talk_message_start(const char *topic, ...);
-void usb_talk_message_append(const char *format, ...);
+void usb_talk_message_start(const char *topic, ...) USB_TALK_FORMAT(1, 2);
+void usb_talk_message_start_id(uint64_t *device_address, const char *topic, ...) USB_TALK_FORMAT(2, 3);
+void usb_talk_message_append(const char *format, ...) USB_TALK_FORMAT(1, 2);
+void usb_talk_message_append_value(const value_t *value);
 void usb_talk_message_send(void);
 
 void usb_talk_publish_null(uint64_t *device_address, const char *subtopics);
@@ -45,17 +71,19 @@ void usb_talk_publish_float(uint64_t *device_address, const char *subtopics, flo
 void usb_talk_publish_complex_bool(uint64_t *device_address, const char *subtopic, const char *number, const char *name, bool *state);
 void usb_talk_publish_event_count(uint64_t *device_address, const char *name, uint16_t *event_count);
 void usb_talk_publish_led(uint64_t *device_address, bool *state);
-void usb_talk_publish_temperature(uint64_t *device_address, uint8_t channel, float *celsius);
-void usb_talk_publish_humidity(uint64_t *device_address, uint8_t channel, float *relative_humidity);
-void usb_talk_publish_lux_meter(uint64_t *device_address, uint8_t channel, float *illuminance);
-void usb_talk_publish_barometer(uint64_t *device_address, uint8_t channel, float *pascal, float *altitude);
-void usb_talk_publish_co2(uint64_t *device_address, float *concentration);
+void usb_talk_publish_temperature(uint64_t *device_address, uint8_t channel, const value_t *celsius);
+void usb_talk_publish_humidity(uint64_t *device_address, uint8_t channel, const value_t *relative_humidity);
+void usb_talk_publish_lux_meter(uint64_t *device_address, uint8_t channel, const value_t *illuminance);
+void usb_talk_publish_barometer(uint64_t *device_address, uint8_t channel, const value_t *pascal, const value_t *altitude);
+void usb_talk_publish_co2(uint64_t *device_address, const value_t *concentration);
+void usb_talk_publish_battery(uint64_t *device_address, const value_t *voltage);
 void usb_talk_publish_relay(uint64_t *device_address, bool *state);
 void usb_talk_publish_module_relay(uint64_t *device_address, uint8_t *number, bc_module_relay_state_t *state);
 void usb_talk_publish_encoder(uint64_t *device_address, int *increment);
 void usb_talk_publish_flood_detector(uint64_t *device_address, const char *number, bool *state);
 void usb_talk_publish_accelerometer_acceleration(uint64_t *device_address, float *x_axis, float *y_axis, float *z_axis);
-void usb_talk_publish_nodes(uint64_t *peer_devices_address, int lenght);
+void usb_talk_publish_nodes(const uint64_t *peer_devices_address, int length);
+void usb_talk_publish_nodes_page(const uint64_t *peer_devices_address, int length, int page, int pages);
 void usb_talk_publish_node(const char *event, uint64_t *peer_device_address);
 
 bool usb_talk_payload_get_bool(usb_talk_payload_t *payload, bool *value);
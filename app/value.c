@@ -0,0 +1,40 @@
+#include <value.h>
+#include <stdio.h>
+
+value_t value_from_float(float number, uint8_t decimals, value_unit_t unit)
+{
+    value_t value;
+    float scaled = number * VALUE_SCALE(decimals);
+
+    value.raw = (int32_t) (scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+    value.decimals = decimals;
+    value.unit = unit;
+
+    return value;
+}
+
+float value_to_float(const value_t *value)
+{
+    return (float) value->raw / VALUE_SCALE(value->decimals);
+}
+
+int32_t value_distance(const value_t *a, const value_t *b)
+{
+    int32_t distance = a->raw - b->raw;
+
+    return distance < 0 ? -distance : distance;
+}
+
+int value_format(char *buffer, size_t size, const value_t *value)
+{
+    int32_t scale = VALUE_SCALE(value->decimals);
+    uint32_t magnitude = value->raw < 0 ? -(uint32_t) value->raw : (uint32_t) value->raw;
+    const char *sign = value->raw < 0 ? "-" : "";
+
+    if (value->decimals == 0)
+    {
+        return snprintf(buffer, size, "%s%lu", sign, (unsigned long) magnitude);
+    }
+
+    return snprintf(buffer, size, "%s%lu.%0*lu", sign, (unsigned long) (magnitude / scale), value->decimals, (unsigned long) (magnitude % scale));
+}
@@ -0,0 +1,63 @@
+#ifndef _VALUE_H
+#define _VALUE_H
+
+#include <bc_common.h>
+
+// Decimals match the precision every quantity is published with
+#define VALUE_TEMPERATURE_DECIMALS 2
+#define VALUE_HUMIDITY_DECIMALS 1
+#define VALUE_ILLUMINANCE_DECIMALS 1
+#define VALUE_PRESSURE_DECIMALS 2
+#define VALUE_ALTITUDE_DECIMALS 2
+#define VALUE_CONCENTRATION_DECIMALS 0
+#define VALUE_VOLTAGE_DECIMALS 2
+
+#define VALUE_SCALE(decimals) ((decimals) == 0 ? 1 : (decimals) == 1 ? 10 : (decimals) == 2 ? 100 : 1000)
+
+// Constant expression, usable in static initializers
+#define VALUE_FIXED(number, decimals) ((int32_t) ((number) * VALUE_SCALE(decimals) + ((number) < 0 ? -0.5f : 0.5f)))
+
+#define VALUE_TEMPERATURE(number) value_from_float((number), VALUE_TEMPERATURE_DECIMALS, VALUE_UNIT_CELSIUS)
+#define VALUE_HUMIDITY(number) value_from_float((number), VALUE_HUMIDITY_DECIMALS, VALUE_UNIT_PERCENT)
+#define VALUE_ILLUMINANCE(number) value_from_float((number), VALUE_ILLUMINANCE_DECIMALS, VALUE_UNIT_LUX)
+#define VALUE_PRESSURE(number) value_from_float((number), VALUE_PRESSURE_DECIMALS, VALUE_UNIT_PASCAL)
+#define VALUE_ALTITUDE(number) value_from_float((number), VALUE_ALTITUDE_DECIMALS, VALUE_UNIT_METER)
+#define VALUE_CONCENTRATION(number) value_from_float((number), VALUE_CONCENTRATION_DECIMALS, VALUE_UNIT_PPM)
+#define VALUE_VOLTAGE(number) value_from_float((number), VALUE_VOLTAGE_DECIMALS, VALUE_UNIT_VOLT)
+
+#define VALUE_FORMAT_LENGTH 13
+
+typedef enum
+{
+    VALUE_UNIT_NONE = 0,
+    VALUE_UNIT_CELSIUS = 1,
+    VALUE_UNIT_PERCENT = 2,
+    VALUE_UNIT_LUX = 3,
+    VALUE_UNIT_PASCAL = 4,
+    VALUE_UNIT_METER = 5,
+    VALUE_UNIT_PPM = 6,
+    VALUE_UNIT_VOLT = 7
+
+} value_unit_t;
+
+// Scaled integer, raw / 10^decimals is the value in the given unit
+typedef struct
+{
+    int32_t raw;
+    uint8_t decimals;
+    uint8_t unit;
+
+} value_t;
+
+// The only place where floats coming from the SDK are converted
+value_t value_from_float(float number, uint8_t decimals, value_unit_t unit);
+
+float value_to_float(const value_t *value);
+
+// Absolute difference in raw units, both values are expected to have the same decimals
+int32_t value_distance(const value_t *a, const value_t *b);
+
+// Formats as a JSON number with exactly the value decimals, returns the length
+int value_format(char *buffer, size_t size, const value_t *value);
+
+#endif
@@ -5,13 +5,19 @@
 #include <bcl.h>
 
 void vv_radio_send_update(struct vv_radio_single_float_packet *source) {
-    static uint8_t buffer[VV_RADIO_MESSAGE_SIZE];    
+    static uint8_t buffer[VV_RADIO_MESSAGE_SIZE];
+    vv_radio_encode_update(source, buffer);
+
+    bc_radio_pub_buffer(buffer, sizeof(buffer));
+}
+
+size_t vv_radio_encode_update(struct vv_radio_single_float_packet *source, uint8_t *buffer) {
     buffer[VV_RADIO_TYPE] = VV_RADIO_SINGLE_FLOAT;
-    memcpy(buffer + VV_RADIO_ADDRESS, &source -> device_address, sizeof(uint64_t));    
+    memcpy(buffer + VV_RADIO_ADDRESS, &source -> device_address, sizeof(uint64_t));
     buffer[VV_RADIO_DATA_TYPE] = source -> type;
-    memcpy(buffer + VV_RADIO_VALUE, &source -> value, sizeof(float));    
+    memcpy(buffer + VV_RADIO_VALUE, &source -> value, sizeof(float));
 
-    bc_radio_pub_buffer(buffer, sizeof(buffer));
+    return VV_RADIO_MESSAGE_SIZE;
 }
 
 void vv_radio_parse_incoming_buffer(size_t length, uint8_t *buffer, struct vv_radio_single_float_packet *target) {
@@ -36,5 +36,6 @@ struct vv_radio_single_float_packet {
 void vv_radio_listening_init();
 void vv_radio_parse_incoming_buffer(size_t length, uint8_t *buffer, struct vv_radio_single_float_packet *target);
 void vv_radio_send_update(struct vv_radio_single_float_packet *source);
+size_t vv_radio_encode_update(struct vv_radio_single_float_packet *source, uint8_t *buffer);
 
 #endif
@@ -2,4 +2,4 @@
 
 set -eux
 
-make release
+make ram-map RAM_MAP_TYPE=release
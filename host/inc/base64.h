@@ -0,0 +1,9 @@
+#ifndef _BASE64_H
+#define _BASE64_H
+
+#include <bc_common.h>
+
+size_t base64_calculate_decode_length(const char *input, uint32_t input_length);
+bool base64_decode(const char *input, uint32_t input_length, uint8_t *output, uint32_t *output_length);
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef _BC_BUTTON_H
+#define _BC_BUTTON_H
+
+#include <bc_gpio.h>
+
+typedef enum
+{
+    BC_BUTTON_EVENT_PRESS = 0,
+    BC_BUTTON_EVENT_RELEASE = 1,
+    BC_BUTTON_EVENT_CLICK = 2,
+    BC_BUTTON_EVENT_HOLD = 3
+
+} bc_button_event_t;
+
+typedef struct
+{
+    int gpio;
+    int virtual_channel;
+
+} bc_button_channel_t;
+
+typedef struct bc_button_t bc_button_t;
+
+// Never pressed on the host, the handler is only stored
+struct bc_button_t
+{
+    bc_button_channel_t _channel;
+    void (*event_handler)(bc_button_t *, bc_button_event_t, void *);
+    void *event_param;
+
+};
+
+void bc_button_init(bc_button_t *self, int gpio_channel, bc_gpio_pull_t gpio_pull, bool idle_state);
+void bc_button_init_virtual(bc_button_t *self, int channel, const void *driver, bool idle_state);
+void bc_button_set_event_handler(bc_button_t *self, void (*event_handler)(bc_button_t *, bc_button_event_t, void *), void *event_param);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef _BC_COMMON_H
+#define _BC_COMMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <ctype.h>
+#include <math.h>
+#include <inttypes.h>
+
+#define BC_MODULE_COMMON
+
+#endif
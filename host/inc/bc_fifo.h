@@ -0,0 +1,19 @@
+#ifndef _BC_FIFO_H
+#define _BC_FIFO_H
+
+#include <bc_common.h>
+
+typedef struct
+{
+    void *buffer;
+    size_t size;
+    size_t head;
+    size_t tail;
+
+} bc_fifo_t;
+
+void bc_fifo_init(bc_fifo_t *fifo, void *buffer, size_t size);
+size_t bc_fifo_write(bc_fifo_t *fifo, const void *buffer, size_t length);
+size_t bc_fifo_read(bc_fifo_t *fifo, void *buffer, size_t length);
+
+#endif
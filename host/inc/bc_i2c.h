@@ -0,0 +1,24 @@
+#ifndef _BC_I2C_H
+#define _BC_I2C_H
+
+#include <bc_common.h>
+
+typedef enum
+{
+    BC_I2C_I2C0 = 0,
+    BC_I2C_I2C1 = 1
+
+} bc_i2c_channel_t;
+
+typedef enum
+{
+    BC_I2C_SPEED_100_KHZ = 0,
+    BC_I2C_SPEED_400_KHZ = 1
+
+} bc_i2c_speed_t;
+
+// Nothing answers on the buses, every transfer fails
+void bc_i2c_init(bc_i2c_channel_t channel, bc_i2c_speed_t speed);
+bool bc_i2c_memory_read_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t *data);
+
+#endif
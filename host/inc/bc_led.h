@@ -0,0 +1,33 @@
+#ifndef _BC_LED_H
+#define _BC_LED_H
+
+#include <bc_gpio.h>
+#include <bc_tick.h>
+
+typedef enum
+{
+    BC_LED_MODE_TOGGLE = 0,
+    BC_LED_MODE_OFF = 1,
+    BC_LED_MODE_ON = 2,
+    BC_LED_MODE_BLINK = 3,
+    BC_LED_MODE_BLINK_SLOW = 4,
+    BC_LED_MODE_BLINK_FAST = 5,
+    BC_LED_MODE_FLASH = 6
+
+} bc_led_mode_t;
+
+// No pin behind it, only the state the firmware would have shown
+typedef struct
+{
+    int channel;
+    bc_led_mode_t mode;
+    bc_tick_t pulse_end;
+
+} bc_led_t;
+
+void bc_led_init(bc_led_t *self, int gpio_channel, bool open_drain, int idle_state);
+void bc_led_set_mode(bc_led_t *self, bc_led_mode_t mode);
+void bc_led_pulse(bc_led_t *self, bc_tick_t duration);
+bool bc_led_is_pulse(bc_led_t *self);
+
+#endif
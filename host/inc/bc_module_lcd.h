@@ -0,0 +1,40 @@
+#ifndef _BC_MODULE_LCD_H
+#define _BC_MODULE_LCD_H
+
+#include <bc_common.h>
+
+#define BC_MODULE_LCD_BUTTON_LEFT 0
+#define BC_MODULE_LCD_BUTTON_RIGHT 1
+
+typedef struct
+{
+    uint8_t height;
+
+} bc_font_t;
+
+extern const bc_font_t bc_font_ubuntu_11;
+extern const bc_font_t bc_font_ubuntu_13;
+extern const bc_font_t bc_font_ubuntu_15;
+extern const bc_font_t bc_font_ubuntu_24;
+extern const bc_font_t bc_font_ubuntu_28;
+extern const bc_font_t bc_font_ubuntu_33;
+
+typedef struct
+{
+    uint8_t framebuffer[128 * 128 / 8];
+
+} bc_module_lcd_framebuffer_t;
+
+extern bc_module_lcd_framebuffer_t _bc_module_lcd_framebuffer;
+
+// Drawing only counts, there is no display to show it
+void bc_module_lcd_init(bc_module_lcd_framebuffer_t *framebuffer);
+void bc_module_lcd_clear(void);
+bool bc_module_lcd_update(void);
+bool bc_module_lcd_is_ready(void);
+void bc_module_lcd_set_font(const bc_font_t *font);
+int bc_module_lcd_draw_string(int left, int top, char *str, bool color);
+void bc_module_lcd_draw_line(int x0, int y0, int x1, int y1, bool color);
+const void *bc_module_lcd_get_button_driver(void);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef _BC_MODULE_PIR_H
+#define _BC_MODULE_PIR_H
+
+#include <bc_common.h>
+
+typedef enum
+{
+    BC_MODULE_PIR_EVENT_ERROR = 0,
+    BC_MODULE_PIR_EVENT_MOTION = 1
+
+} bc_module_pir_event_t;
+
+typedef struct bc_module_pir_t bc_module_pir_t;
+
+struct bc_module_pir_t
+{
+    void (*event_handler)(bc_module_pir_t *, bc_module_pir_event_t, void *);
+    void *event_param;
+
+};
+
+void bc_module_pir_init(bc_module_pir_t *self);
+void bc_module_pir_set_event_handler(bc_module_pir_t *self, void (*event_handler)(bc_module_pir_t *, bc_module_pir_event_t, void *), void *event_param);
+
+#endif
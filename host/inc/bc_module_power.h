@@ -0,0 +1,10 @@
+#ifndef _BC_MODULE_POWER_H
+#define _BC_MODULE_POWER_H
+
+#include <bc_common.h>
+
+void bc_module_power_init(void);
+void bc_module_power_relay_set_state(bool state);
+bool bc_module_power_relay_get_state(void);
+
+#endif
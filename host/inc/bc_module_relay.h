@@ -0,0 +1,29 @@
+#ifndef _BC_MODULE_RELAY_H
+#define _BC_MODULE_RELAY_H
+
+#include <bc_tick.h>
+
+#define BC_MODULE_RELAY_I2C_ADDRESS_DEFAULT 0x3b
+#define BC_MODULE_RELAY_I2C_ADDRESS_ALTERNATE 0x3f
+
+typedef enum
+{
+    BC_MODULE_RELAY_STATE_FALSE = 0,
+    BC_MODULE_RELAY_STATE_TRUE = 1,
+    BC_MODULE_RELAY_STATE_UNKNOWN = 2
+
+} bc_module_relay_state_t;
+
+typedef struct
+{
+    uint8_t i2c_address;
+    bc_module_relay_state_t state;
+
+} bc_module_relay_t;
+
+bool bc_module_relay_init(bc_module_relay_t *self, uint8_t i2c_address);
+void bc_module_relay_set_state(bc_module_relay_t *self, bool state);
+bc_module_relay_state_t bc_module_relay_get_state(bc_module_relay_t *self);
+void bc_module_relay_pulse(bc_module_relay_t *self, bool direction, bc_tick_t duration);
+
+#endif
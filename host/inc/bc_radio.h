@@ -0,0 +1,94 @@
+#ifndef _BC_RADIO_H
+#define _BC_RADIO_H
+
+#include <bc_common.h>
+#include <bc_tick.h>
+
+#ifndef BC_RADIO_MAX_DEVICES
+#define BC_RADIO_MAX_DEVICES 8
+#endif
+
+#define BC_RADIO_MAX_BUFFER_SIZE 55
+#define BC_RADIO_NODE_MAX_COMPOUND_BUFFER_SIZE (BC_RADIO_MAX_BUFFER_SIZE - 8 - 2)
+
+#define BC_RADIO_NODE_STATE_LED 0x00
+#define BC_RADIO_NODE_STATE_RELAY_MODULE_0 0x01
+#define BC_RADIO_NODE_STATE_RELAY_MODULE_1 0x02
+#define BC_RADIO_NODE_STATE_POWER_MODULE_RELAY 0x03
+
+typedef enum
+{
+    BC_RADIO_MODE_UNKNOWN = 0,
+    BC_RADIO_MODE_GATEWAY = 1,
+    BC_RADIO_MODE_NODE_LISTENING = 2,
+    BC_RADIO_MODE_NODE_SLEEPING = 3
+
+} bc_radio_mode_t;
+
+typedef enum
+{
+    BC_RADIO_EVENT_INIT_FAILURE = 0,
+    BC_RADIO_EVENT_INIT_DONE = 1,
+    BC_RADIO_EVENT_ATTACH = 2,
+    BC_RADIO_EVENT_ATTACH_FAILURE = 3,
+    BC_RADIO_EVENT_DETACH = 4,
+    BC_RADIO_EVENT_SCAN_FIND_DEVICE = 5,
+    BC_RADIO_EVENT_TX_DONE = 6,
+    BC_RADIO_EVENT_TX_ERROR = 7
+
+} bc_radio_event_t;
+
+typedef enum
+{
+    BC_RADIO_NODE_LED_STRIP_EFFECT_TEST = 0,
+    BC_RADIO_NODE_LED_STRIP_EFFECT_RAINBOW = 1,
+    BC_RADIO_NODE_LED_STRIP_EFFECT_RAINBOW_CYCLE = 2,
+    BC_RADIO_NODE_LED_STRIP_EFFECT_THEATER_CHASE_RAINBOW = 3,
+    BC_RADIO_NODE_LED_STRIP_EFFECT_COLOR_WIPE = 4,
+    BC_RADIO_NODE_LED_STRIP_EFFECT_THEATER_CHASE = 5
+
+} bc_radio_node_led_strip_effect_t;
+
+// No transceiver, packets sent to nodes are logged to stderr and packets
+// from nodes are injected with host_radio_* from the host main loop
+void bc_radio_init(bc_radio_mode_t mode);
+void bc_radio_set_event_handler(void (*event_handler)(bc_radio_event_t, void *), void *event_param);
+uint64_t bc_radio_get_event_id(void);
+uint64_t bc_radio_get_my_id(void);
+void bc_radio_get_peer_id(uint64_t *peer_id, int length);
+bool bc_radio_peer_device_add(uint64_t id);
+bool bc_radio_peer_device_remove(uint64_t id);
+bool bc_radio_peer_device_purge_all(void);
+bool bc_radio_is_peer_device(uint64_t id);
+void bc_radio_scan_start(void);
+void bc_radio_scan_stop(void);
+void bc_radio_pairing_mode_start(void);
+void bc_radio_pairing_mode_stop(void);
+void bc_radio_automatic_pairing_start(void);
+void bc_radio_automatic_pairing_stop(void);
+bool bc_radio_pub_buffer(void *buffer, size_t length);
+
+bool bc_radio_node_state_set(uint64_t *id, uint8_t state_id, bool *state);
+bool bc_radio_node_state_get(uint64_t *id, uint8_t state_id);
+bool bc_radio_node_led_strip_color_set(uint64_t *id, uint32_t color);
+bool bc_radio_node_led_strip_brightness_set(uint64_t *id, uint8_t brightness);
+bool bc_radio_node_led_strip_compound_set(uint64_t *id, uint8_t *compound, size_t length);
+bool bc_radio_node_led_strip_effect_set(uint64_t *id, bc_radio_node_led_strip_effect_t type, uint16_t wait, uint32_t color);
+bool bc_radio_node_led_strip_thermometer_set(uint64_t *id, float temperature, int8_t min, int8_t max, uint8_t white_dots, float *set_point, uint32_t color);
+
+// Implemented by the application
+void bc_radio_on_info(uint64_t *id, char *firmware, char *version);
+void bc_radio_pub_on_event_count(uint64_t *id, uint8_t event_id, uint16_t *event_count);
+void bc_radio_pub_on_temperature(uint64_t *id, uint8_t channel, float *celsius);
+void bc_radio_pub_on_humidity(uint64_t *id, uint8_t channel, float *percentage);
+void bc_radio_pub_on_lux_meter(uint64_t *id, uint8_t channel, float *illuminance);
+void bc_radio_pub_on_barometer(uint64_t *id, uint8_t channel, float *pressure, float *altitude);
+void bc_radio_pub_on_co2(uint64_t *id, float *concentration);
+void bc_radio_pub_on_battery(uint64_t *id, float *voltage);
+void bc_radio_pub_on_state(uint64_t *id, uint8_t state_id, bool *state);
+void bc_radio_pub_on_bool(uint64_t *id, char *subtopic, bool *value);
+void bc_radio_pub_on_int(uint64_t *id, char *subtopic, int *value);
+void bc_radio_pub_on_float(uint64_t *id, char *subtopic, float *value);
+void bc_radio_pub_on_buffer(uint64_t *id, uint8_t *buffer, size_t length);
+
+#endif
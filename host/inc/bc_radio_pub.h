@@ -0,0 +1,29 @@
+#ifndef _BC_RADIO_PUB_H
+#define _BC_RADIO_PUB_H
+
+#include <bc_radio.h>
+
+#define BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_DEFAULT 0x00
+#define BC_RADIO_PUB_CHANNEL_R1_I2C0_ADDRESS_ALTERNATE 0x01
+#define BC_RADIO_PUB_CHANNEL_R1_I2C1_ADDRESS_DEFAULT 0x80
+#define BC_RADIO_PUB_CHANNEL_R1_I2C1_ADDRESS_ALTERNATE 0x81
+#define BC_RADIO_PUB_CHANNEL_R2_I2C0_ADDRESS_DEFAULT 0x02
+#define BC_RADIO_PUB_CHANNEL_R2_I2C0_ADDRESS_ALTERNATE 0x03
+#define BC_RADIO_PUB_CHANNEL_R3_I2C0_ADDRESS_DEFAULT 0x04
+#define BC_RADIO_PUB_CHANNEL_R3_I2C0_ADDRESS_ALTERNATE 0x05
+#define BC_RADIO_PUB_CHANNEL_A 0x06
+#define BC_RADIO_PUB_CHANNEL_B 0x07
+#define BC_RADIO_PUB_CHANNEL_SET_POINT 0x08
+
+#define BC_RADIO_PUB_EVENT_PUSH_BUTTON 0
+#define BC_RADIO_PUB_EVENT_PIR_MOTION 1
+#define BC_RADIO_PUB_EVENT_LCD_BUTTON_LEFT 2
+#define BC_RADIO_PUB_EVENT_LCD_BUTTON_RIGHT 3
+#define BC_RADIO_PUB_EVENT_ACCELEROMETER_ALERT 4
+
+#define BC_RADIO_PUB_STATE_LED 0
+#define BC_RADIO_PUB_STATE_RELAY_MODULE_0 1
+#define BC_RADIO_PUB_STATE_RELAY_MODULE_1 2
+#define BC_RADIO_PUB_STATE_POWER_MODULE_RELAY 3
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef _BC_SCHEDULER_H
+#define _BC_SCHEDULER_H
+
+#include <bc_tick.h>
+
+#ifndef BC_SCHEDULER_MAX_TASKS
+#define BC_SCHEDULER_MAX_TASKS 64
+#endif
+
+typedef size_t bc_scheduler_task_id_t;
+
+void bc_scheduler_init(void);
+
+// Runs every task that is due once, returns the tick of the next planned one
+bc_tick_t bc_scheduler_run_once(size_t *count);
+
+bc_scheduler_task_id_t bc_scheduler_register(void (*task)(void *), void *param, bc_tick_t tick);
+void bc_scheduler_unregister(bc_scheduler_task_id_t task_id);
+bc_scheduler_task_id_t bc_scheduler_get_current_task_id(void);
+bc_tick_t bc_scheduler_get_spin_tick(void);
+void bc_scheduler_plan_now(bc_scheduler_task_id_t task_id);
+void bc_scheduler_plan_absolute(bc_scheduler_task_id_t task_id, bc_tick_t tick);
+void bc_scheduler_plan_relative(bc_scheduler_task_id_t task_id, bc_tick_t tick);
+void bc_scheduler_plan_current_now(void);
+void bc_scheduler_plan_current_absolute(bc_tick_t tick);
+void bc_scheduler_plan_current_relative(bc_tick_t tick);
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _BC_TAG_BAROMETER_H
+#define _BC_TAG_BAROMETER_H
+
+#include <bc_i2c.h>
+#include <bc_tick.h>
+
+typedef enum
+{
+    BC_TAG_BAROMETER_EVENT_ERROR = 0,
+    BC_TAG_BAROMETER_EVENT_UPDATE = 1
+
+} bc_tag_barometer_event_t;
+
+typedef struct bc_tag_barometer_t bc_tag_barometer_t;
+
+struct bc_tag_barometer_t
+{
+    void (*event_handler)(bc_tag_barometer_t *, bc_tag_barometer_event_t, void *);
+    void *event_param;
+
+};
+
+// Never present on the host, measurements fail
+void bc_tag_barometer_init(bc_tag_barometer_t *self, bc_i2c_channel_t i2c_channel);
+void bc_tag_barometer_set_event_handler(bc_tag_barometer_t *self, void (*event_handler)(bc_tag_barometer_t *, bc_tag_barometer_event_t, void *), void *event_param);
+void bc_tag_barometer_set_update_interval(bc_tag_barometer_t *self, bc_tick_t interval);
+bool bc_tag_barometer_measure(bc_tag_barometer_t *self);
+bool bc_tag_barometer_get_pressure_pascal(bc_tag_barometer_t *self, float *pascal);
+bool bc_tag_barometer_get_altitude_meter(bc_tag_barometer_t *self, float *meter);
+
+#endif
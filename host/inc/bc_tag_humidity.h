@@ -0,0 +1,45 @@
+#ifndef _BC_TAG_HUMIDITY_H
+#define _BC_TAG_HUMIDITY_H
+
+#include <bc_i2c.h>
+#include <bc_tick.h>
+
+typedef enum
+{
+    BC_TAG_HUMIDITY_EVENT_ERROR = 0,
+    BC_TAG_HUMIDITY_EVENT_UPDATE = 1
+
+} bc_tag_humidity_event_t;
+
+typedef enum
+{
+    BC_TAG_HUMIDITY_REVISION_R1 = 0,
+    BC_TAG_HUMIDITY_REVISION_R2 = 1,
+    BC_TAG_HUMIDITY_REVISION_R3 = 2
+
+} bc_tag_humidity_revision_t;
+
+typedef enum
+{
+    BC_TAG_HUMIDITY_I2C_ADDRESS_DEFAULT = 0,
+    BC_TAG_HUMIDITY_I2C_ADDRESS_ALTERNATE = 1
+
+} bc_tag_humidity_i2c_address_t;
+
+typedef struct bc_tag_humidity_t bc_tag_humidity_t;
+
+struct bc_tag_humidity_t
+{
+    void (*event_handler)(bc_tag_humidity_t *, bc_tag_humidity_event_t, void *);
+    void *event_param;
+
+};
+
+// Never present on the host, measurements fail
+void bc_tag_humidity_init(bc_tag_humidity_t *self, bc_tag_humidity_revision_t revision, bc_i2c_channel_t i2c_channel, bc_tag_humidity_i2c_address_t i2c_address);
+void bc_tag_humidity_set_event_handler(bc_tag_humidity_t *self, void (*event_handler)(bc_tag_humidity_t *, bc_tag_humidity_event_t, void *), void *event_param);
+void bc_tag_humidity_set_update_interval(bc_tag_humidity_t *self, bc_tick_t interval);
+bool bc_tag_humidity_measure(bc_tag_humidity_t *self);
+bool bc_tag_humidity_get_humidity_percentage(bc_tag_humidity_t *self, float *percentage);
+
+#endif
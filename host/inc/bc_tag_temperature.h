@@ -0,0 +1,37 @@
+#ifndef _BC_TAG_TEMPERATURE_H
+#define _BC_TAG_TEMPERATURE_H
+
+#include <bc_i2c.h>
+#include <bc_tick.h>
+
+typedef enum
+{
+    BC_TAG_TEMPERATURE_EVENT_ERROR = 0,
+    BC_TAG_TEMPERATURE_EVENT_UPDATE = 1
+
+} bc_tag_temperature_event_t;
+
+typedef enum
+{
+    BC_TAG_TEMPERATURE_I2C_ADDRESS_DEFAULT = 0x48,
+    BC_TAG_TEMPERATURE_I2C_ADDRESS_ALTERNATE = 0x49
+
+} bc_tag_temperature_i2c_address_t;
+
+typedef struct bc_tag_temperature_t bc_tag_temperature_t;
+
+struct bc_tag_temperature_t
+{
+    void (*event_handler)(bc_tag_temperature_t *, bc_tag_temperature_event_t, void *);
+    void *event_param;
+
+};
+
+// Never present on the host, measurements fail
+void bc_tag_temperature_init(bc_tag_temperature_t *self, bc_i2c_channel_t i2c_channel, bc_tag_temperature_i2c_address_t i2c_address);
+void bc_tag_temperature_set_event_handler(bc_tag_temperature_t *self, void (*event_handler)(bc_tag_temperature_t *, bc_tag_temperature_event_t, void *), void *event_param);
+void bc_tag_temperature_set_update_interval(bc_tag_temperature_t *self, bc_tick_t interval);
+bool bc_tag_temperature_measure(bc_tag_temperature_t *self);
+bool bc_tag_temperature_get_temperature_celsius(bc_tag_temperature_t *self, float *celsius);
+
+#endif
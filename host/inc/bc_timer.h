@@ -0,0 +1,11 @@
+#ifndef _BC_TIMER_H
+#define _BC_TIMER_H
+
+#include <bc_common.h>
+
+void bc_timer_init(void);
+void bc_timer_start(void);
+uint16_t bc_timer_get_microseconds(void);
+void bc_timer_stop(void);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef _BC_UART_H
+#define _BC_UART_H
+
+#include <bc_fifo.h>
+#include <bc_tick.h>
+
+typedef enum
+{
+    BC_UART_UART0 = 0,
+    BC_UART_UART1 = 1,
+    BC_UART_UART2 = 2
+
+} bc_uart_channel_t;
+
+typedef enum
+{
+    BC_UART_BAUDRATE_9600 = 0,
+    BC_UART_BAUDRATE_115200 = 1
+
+} bc_uart_baudrate_t;
+
+typedef enum
+{
+    BC_UART_SETTING_8N1 = 0
+
+} bc_uart_setting_t;
+
+typedef enum
+{
+    BC_UART_EVENT_ASYNC_WRITE_DONE = 0,
+    BC_UART_EVENT_ASYNC_READ_DATA = 1,
+    BC_UART_EVENT_ASYNC_READ_TIMEOUT = 2
+
+} bc_uart_event_t;
+
+// Every channel is the process stdin and stdout
+void bc_uart_init(bc_uart_channel_t channel, bc_uart_baudrate_t baudrate, bc_uart_setting_t setting);
+void bc_uart_set_async_fifo(bc_uart_channel_t channel, bc_fifo_t *write_fifo, bc_fifo_t *read_fifo);
+void bc_uart_set_event_handler(bc_uart_channel_t channel, void (*event_handler)(bc_uart_channel_t, bc_uart_event_t, void *), void *event_param);
+bool bc_uart_async_read_start(bc_uart_channel_t channel, bc_tick_t timeout);
+size_t bc_uart_async_read(bc_uart_channel_t channel, void *buffer, size_t length);
+size_t bc_uart_async_write(bc_uart_channel_t channel, const void *buffer, size_t length);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef _BCL_H
+#define _BCL_H
+
+// Host stand-in for the SDK umbrella header, see README.md
+
+#include <bc_common.h>
+#include <bc_tick.h>
+#include <bc_scheduler.h>
+#include <bc_gpio.h>
+#include <bc_led.h>
+#include <bc_button.h>
+#include <bc_fifo.h>
+#include <bc_uart.h>
+#include <bc_usb_cdc.h>
+#include <bc_i2c.h>
+#include <bc_eeprom.h>
+#include <bc_timer.h>
+#include <bc_radio.h>
+#include <bc_radio_pub.h>
+#include <bc_module_lcd.h>
+#include <bc_module_relay.h>
+#include <bc_module_power.h>
+#include <bc_module_co2.h>
+#include <bc_module_pir.h>
+#include <bc_tag_temperature.h>
+#include <bc_tag_humidity.h>
+#include <bc_tag_lux_meter.h>
+#include <bc_tag_barometer.h>
+
+void application_init(void);
+void application_task(void);
+
+#endif
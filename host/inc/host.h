@@ -0,0 +1,20 @@
+#ifndef _HOST_H
+#define _HOST_H
+
+#include <bc_common.h>
+#include <bc_tick.h>
+
+// Only used by host/src/main.c, the firmware never includes this
+
+// Bytes read from stdin, handed to whichever of USB CDC or UART the firmware reads
+void host_input_push(const void *buffer, size_t length);
+bool host_input_pending(void);
+
+// Loads the EEPROM image from path when it exists and saves it there after every write
+void host_eeprom_set_file(const char *path);
+
+// Radio traffic from nodes, the calls the SDK would make on a received packet
+void host_radio_event(int event, uint64_t id);
+bool host_radio_command(const char *line);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef _JSMN_H
+#define _JSMN_H
+
+#include <stddef.h>
+
+typedef enum
+{
+    JSMN_UNDEFINED = 0,
+    JSMN_OBJECT = 1,
+    JSMN_ARRAY = 2,
+    JSMN_STRING = 3,
+    JSMN_PRIMITIVE = 4
+
+} jsmntype_t;
+
+enum jsmnerr
+{
+    JSMN_ERROR_NOMEM = -1,
+    JSMN_ERROR_INVAL = -2,
+    JSMN_ERROR_PART = -3
+};
+
+typedef struct
+{
+    jsmntype_t type;
+    int start;
+    int end;
+    int size;
+
+} jsmntok_t;
+
+typedef struct
+{
+    unsigned int pos;
+    unsigned int toknext;
+    int toksuper;
+
+} jsmn_parser;
+
+void jsmn_init(jsmn_parser *parser);
+
+// Same token layout as the SDK copy: an object counts its keys, a key counts its value
+int jsmn_parse(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, unsigned int num_tokens);
+
+#endif
@@ -0,0 +1,96 @@
+#include <base64.h>
+
+static int _base64_value(char c);
+
+size_t base64_calculate_decode_length(const char *input, uint32_t input_length)
+{
+    size_t padding = 0;
+
+    if ((input_length >= 1) && (input[input_length - 1] == '='))
+    {
+        padding++;
+    }
+
+    if ((input_length >= 2) && (input[input_length - 2] == '='))
+    {
+        padding++;
+    }
+
+    return (input_length * 3) / 4 - padding;
+}
+
+bool base64_decode(const char *input, uint32_t input_length, uint8_t *output, uint32_t *output_length)
+{
+    uint32_t length = 0;
+    uint32_t bits = 0;
+    int count = 0;
+
+    if ((input_length % 4) != 0)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < input_length; i++)
+    {
+        if (input[i] == '=')
+        {
+            break;
+        }
+
+        int value = _base64_value(input[i]);
+
+        if (value < 0)
+        {
+            return false;
+        }
+
+        bits = (bits << 6) | (uint32_t) value;
+        count += 6;
+
+        if (count >= 8)
+        {
+            count -= 8;
+
+            if (length >= *output_length)
+            {
+                return false;
+            }
+
+            output[length++] = (uint8_t) (bits >> count);
+        }
+    }
+
+    *output_length = length;
+
+    return true;
+}
+
+static int _base64_value(char c)
+{
+    if ((c >= 'A') && (c <= 'Z'))
+    {
+        return c - 'A';
+    }
+
+    if ((c >= 'a') && (c <= 'z'))
+    {
+        return c - 'a' + 26;
+    }
+
+    if ((c >= '0') && (c <= '9'))
+    {
+        return c - '0' + 52;
+    }
+
+    if (c == '+')
+    {
+        return 62;
+    }
+
+    if (c == '/')
+    {
+        return 63;
+    }
+
+    return -1;
+}
@@ -0,0 +1,305 @@
+#include <bcl.h>
+
+// Peripherals the gateway can drive but the host does not have: calls succeed where the
+// firmware does not care, probes and measurements fail so nothing is ever detected
+
+const bc_font_t bc_font_ubuntu_11 = { 11 };
+const bc_font_t bc_font_ubuntu_13 = { 13 };
+const bc_font_t bc_font_ubuntu_15 = { 15 };
+const bc_font_t bc_font_ubuntu_24 = { 24 };
+const bc_font_t bc_font_ubuntu_28 = { 28 };
+const bc_font_t bc_font_ubuntu_33 = { 33 };
+
+bc_module_lcd_framebuffer_t _bc_module_lcd_framebuffer;
+
+static bool _bc_device_power_relay;
+
+void bc_led_init(bc_led_t *self, int gpio_channel, bool open_drain, int idle_state)
+{
+    (void) open_drain;
+    (void) idle_state;
+
+    memset(self, 0, sizeof(*self));
+
+    self->channel = gpio_channel;
+    self->mode = BC_LED_MODE_OFF;
+}
+
+void bc_led_set_mode(bc_led_t *self, bc_led_mode_t mode)
+{
+    self->mode = mode;
+}
+
+void bc_led_pulse(bc_led_t *self, bc_tick_t duration)
+{
+    self->pulse_end = bc_tick_get() + duration;
+}
+
+bool bc_led_is_pulse(bc_led_t *self)
+{
+    return bc_tick_get() < self->pulse_end;
+}
+
+void bc_button_init(bc_button_t *self, int gpio_channel, bc_gpio_pull_t gpio_pull, bool idle_state)
+{
+    (void) gpio_pull;
+    (void) idle_state;
+
+    memset(self, 0, sizeof(*self));
+
+    self->_channel.gpio = gpio_channel;
+}
+
+void bc_button_init_virtual(bc_button_t *self, int channel, const void *driver, bool idle_state)
+{
+    (void) driver;
+    (void) idle_state;
+
+    memset(self, 0, sizeof(*self));
+
+    self->_channel.virtual_channel = channel;
+}
+
+void bc_button_set_event_handler(bc_button_t *self, void (*event_handler)(bc_button_t *, bc_button_event_t, void *), void *event_param)
+{
+    self->event_handler = event_handler;
+    self->event_param = event_param;
+}
+
+void bc_i2c_init(bc_i2c_channel_t channel, bc_i2c_speed_t speed)
+{
+    (void) channel;
+    (void) speed;
+}
+
+bool bc_i2c_memory_read_8b(bc_i2c_channel_t channel, uint8_t device_address, uint32_t memory_address, uint8_t *data)
+{
+    (void) channel;
+    (void) device_address;
+    (void) memory_address;
+    (void) data;
+
+    return false;
+}
+
+void bc_module_lcd_init(bc_module_lcd_framebuffer_t *framebuffer)
+{
+    memset(framebuffer, 0, sizeof(*framebuffer));
+}
+
+void bc_module_lcd_clear(void)
+{
+}
+
+bool bc_module_lcd_update(void)
+{
+    return true;
+}
+
+bool bc_module_lcd_is_ready(void)
+{
+    return true;
+}
+
+void bc_module_lcd_set_font(const bc_font_t *font)
+{
+    (void) font;
+}
+
+int bc_module_lcd_draw_string(int left, int top, char *str, bool color)
+{
+    (void) top;
+    (void) color;
+
+    return left + 6 * (int) strlen(str);
+}
+
+void bc_module_lcd_draw_line(int x0, int y0, int x1, int y1, bool color)
+{
+    (void) x0;
+    (void) y0;
+    (void) x1;
+    (void) y1;
+    (void) color;
+}
+
+const void *bc_module_lcd_get_button_driver(void)
+{
+    return NULL;
+}
+
+bool bc_module_relay_init(bc_module_relay_t *self, uint8_t i2c_address)
+{
+    self->i2c_address = i2c_address;
+    self->state = BC_MODULE_RELAY_STATE_UNKNOWN;
+
+    return false;
+}
+
+void bc_module_relay_set_state(bc_module_relay_t *self, bool state)
+{
+    (void) self;
+    (void) state;
+}
+
+bc_module_relay_state_t bc_module_relay_get_state(bc_module_relay_t *self)
+{
+    return self->state;
+}
+
+void bc_module_relay_pulse(bc_module_relay_t *self, bool direction, bc_tick_t duration)
+{
+    (void) self;
+    (void) direction;
+    (void) duration;
+}
+
+void bc_module_power_init(void)
+{
+    _bc_device_power_relay = false;
+}
+
+void bc_module_power_relay_set_state(bool state)
+{
+    _bc_device_power_relay = state;
+}
+
+bool bc_module_power_relay_get_state(void)
+{
+    return _bc_device_power_relay;
+}
+
+void bc_module_co2_init(void)
+{
+}
+
+void bc_module_co2_set_event_handler(void (*event_handler)(bc_module_co2_event_t, void *), void *event_param)
+{
+    (void) event_handler;
+    (void) event_param;
+}
+
+void bc_module_co2_set_update_interval(bc_tick_t interval)
+{
+    (void) interval;
+}
+
+bool bc_module_co2_measure(void)
+{
+    return false;
+}
+
+bool bc_module_co2_get_concentration_ppm(float *ppm)
+{
+    (void) ppm;
+
+    return false;
+}
+
+void bc_module_pir_init(bc_module_pir_t *self)
+{
+    memset(self, 0, sizeof(*self));
+}
+
+void bc_module_pir_set_event_handler(bc_module_pir_t *self, void (*event_handler)(bc_module_pir_t *, bc_module_pir_event_t, void *), void *event_param)
+{
+    self->event_handler = event_handler;
+    self->event_param = event_param;
+}
+
+#define BC_DEVICE_TAG(name) \
+    void bc_tag_##name##_set_event_handler(bc_tag_##name##_t *self, void (*event_handler)(bc_tag_##name##_t *, bc_tag_##name##_event_t, void *), void *event_param) \
+    { \
+        self->event_handler = event_handler; \
+        self->event_param = event_param; \
+    } \
+    \
+    void bc_tag_##name##_set_update_interval(bc_tag_##name##_t *self, bc_tick_t interval) \
+    { \
+        (void) self; \
+        (void) interval; \
+    } \
+    \
+    bool bc_tag_##name##_measure(bc_tag_##name##_t *self) \
+    { \
+        (void) self; \
+        \
+        return false; \
+    }
+
+BC_DEVICE_TAG(temperature)
+BC_DEVICE_TAG(humidity)
+BC_DEVICE_TAG(lux_meter)
+BC_DEVICE_TAG(barometer)
+
+void bc_tag_temperature_init(bc_tag_temperature_t *self, bc_i2c_channel_t i2c_channel, bc_tag_temperature_i2c_address_t i2c_address)
+{
+    (void) i2c_channel;
+    (void) i2c_address;
+
+    memset(self, 0, sizeof(*self));
+}
+
+bool bc_tag_temperature_get_temperature_celsius(bc_tag_temperature_t *self, float *celsius)
+{
+    (void) self;
+    (void) celsius;
+
+    return false;
+}
+
+void bc_tag_humidity_init(bc_tag_humidity_t *self, bc_tag_humidity_revision_t revision, bc_i2c_channel_t i2c_channel, bc_tag_humidity_i2c_address_t i2c_address)
+{
+    (void) revision;
+    (void) i2c_channel;
+    (void) i2c_address;
+
+    memset(self, 0, sizeof(*self));
+}
+
+bool bc_tag_humidity_get_humidity_percentage(bc_tag_humidity_t *self, float *percentage)
+{
+    (void) self;
+    (void) percentage;
+
+    return false;
+}
+
+void bc_tag_lux_meter_init(bc_tag_lux_meter_t *self, bc_i2c_channel_t i2c_channel, bc_tag_lux_meter_i2c_address_t i2c_address)
+{
+    (void) i2c_channel;
+    (void) i2c_address;
+
+    memset(self, 0, sizeof(*self));
+}
+
+bool bc_tag_lux_meter_get_illuminance_lux(bc_tag_lux_meter_t *self, float *lux)
+{
+    (void) self;
+    (void) lux;
+
+    return false;
+}
+
+void bc_tag_barometer_init(bc_tag_barometer_t *self, bc_i2c_channel_t i2c_channel)
+{
+    (void) i2c_channel;
+
+    memset(self, 0, sizeof(*self));
+}
+
+bool bc_tag_barometer_get_pressure_pascal(bc_tag_barometer_t *self, float *pascal)
+{
+    (void) self;
+    (void) pascal;
+
+    return false;
+}
+
+bool bc_tag_barometer_get_altitude_meter(bc_tag_barometer_t *self, float *meter)
+{
+    (void) self;
+    (void) meter;
+
+    return false;
+}
@@ -0,0 +1,81 @@
+#include <bc_eeprom.h>
+#include <host.h>
+
+// Erased data EEPROM reads as zero, like the STM32L0 one
+static struct
+{
+    uint8_t image[BC_EEPROM_SIZE];
+    const char *path;
+
+} _bc_eeprom;
+
+static void _bc_eeprom_save(void);
+
+void host_eeprom_set_file(const char *path)
+{
+    _bc_eeprom.path = path;
+
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL)
+    {
+        return;
+    }
+
+    if (fread(_bc_eeprom.image, 1, sizeof(_bc_eeprom.image), file) != sizeof(_bc_eeprom.image))
+    {
+        fprintf(stderr, "host: %s is shorter than the EEPROM, the rest reads as erased\n", path);
+    }
+
+    fclose(file);
+}
+
+bool bc_eeprom_write(uint32_t address, const void *buffer, size_t length)
+{
+    if ((address + length) > sizeof(_bc_eeprom.image))
+    {
+        return false;
+    }
+
+    memcpy(_bc_eeprom.image + address, buffer, length);
+
+    _bc_eeprom_save();
+
+    return true;
+}
+
+bool bc_eeprom_read(uint32_t address, void *buffer, size_t length)
+{
+    if ((address + length) > sizeof(_bc_eeprom.image))
+    {
+        return false;
+    }
+
+    memcpy(buffer, _bc_eeprom.image + address, length);
+
+    return true;
+}
+
+size_t bc_eeprom_get_size(void)
+{
+    return sizeof(_bc_eeprom.image);
+}
+
+static void _bc_eeprom_save(void)
+{
+    if (_bc_eeprom.path == NULL)
+    {
+        return;
+    }
+
+    FILE *file = fopen(_bc_eeprom.path, "wb");
+
+    if (file == NULL)
+    {
+        return;
+    }
+
+    fwrite(_bc_eeprom.image, 1, sizeof(_bc_eeprom.image), file);
+
+    fclose(file);
+}
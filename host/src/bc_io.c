@@ -0,0 +1,208 @@
+#include <bcl.h>
+#include <host.h>
+#include <unistd.h>
+
+#define HOST_INPUT_SIZE 4096
+
+// stdin bytes wait here until the firmware reads them, over CDC or UART alike
+static struct
+{
+    uint8_t buffer[HOST_INPUT_SIZE];
+    size_t head;
+    size_t tail;
+
+    void (*uart_event_handler)(bc_uart_channel_t, bc_uart_event_t, void *);
+    void *uart_event_param;
+    bc_uart_channel_t uart_channel;
+    bool uart_reading;
+    bc_scheduler_task_id_t uart_task_id;
+    bool uart_task_registered;
+
+} _bc_io;
+
+static size_t _bc_io_read(void *buffer, size_t length);
+static bool _bc_io_write(const void *buffer, size_t length);
+static void _bc_io_uart_task(void *param);
+
+void host_input_push(const void *buffer, size_t length)
+{
+    const uint8_t *data = buffer;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        size_t next = (_bc_io.head + 1) % HOST_INPUT_SIZE;
+
+        // Same as a UART overrun, the firmware sees a broken line and recovers on the next one
+        if (next == _bc_io.tail)
+        {
+            break;
+        }
+
+        _bc_io.buffer[_bc_io.head] = data[i];
+        _bc_io.head = next;
+    }
+
+    if (_bc_io.uart_reading)
+    {
+        bc_scheduler_plan_now(_bc_io.uart_task_id);
+    }
+}
+
+bool host_input_pending(void)
+{
+    return _bc_io.head != _bc_io.tail;
+}
+
+void bc_usb_cdc_init(void)
+{
+}
+
+bool bc_usb_cdc_write(const void *buffer, size_t length)
+{
+    return _bc_io_write(buffer, length);
+}
+
+size_t bc_usb_cdc_read(void *buffer, size_t length)
+{
+    return _bc_io_read(buffer, length);
+}
+
+void bc_uart_init(bc_uart_channel_t channel, bc_uart_baudrate_t baudrate, bc_uart_setting_t setting)
+{
+    (void) baudrate;
+    (void) setting;
+
+    _bc_io.uart_channel = channel;
+
+    if (!_bc_io.uart_task_registered)
+    {
+        _bc_io.uart_task_id = bc_scheduler_register(_bc_io_uart_task, NULL, BC_TICK_INFINITY);
+        _bc_io.uart_task_registered = true;
+    }
+}
+
+void bc_uart_set_async_fifo(bc_uart_channel_t channel, bc_fifo_t *write_fifo, bc_fifo_t *read_fifo)
+{
+    (void) channel;
+    (void) write_fifo;
+    (void) read_fifo;
+}
+
+void bc_uart_set_event_handler(bc_uart_channel_t channel, void (*event_handler)(bc_uart_channel_t, bc_uart_event_t, void *), void *event_param)
+{
+    (void) channel;
+
+    _bc_io.uart_event_handler = event_handler;
+    _bc_io.uart_event_param = event_param;
+}
+
+bool bc_uart_async_read_start(bc_uart_channel_t channel, bc_tick_t timeout)
+{
+    (void) channel;
+    (void) timeout;
+
+    _bc_io.uart_reading = true;
+
+    return true;
+}
+
+size_t bc_uart_async_read(bc_uart_channel_t channel, void *buffer, size_t length)
+{
+    (void) channel;
+
+    return _bc_io_read(buffer, length);
+}
+
+size_t bc_uart_async_write(bc_uart_channel_t channel, const void *buffer, size_t length)
+{
+    (void) channel;
+
+    return _bc_io_write(buffer, length) ? length : 0;
+}
+
+void bc_fifo_init(bc_fifo_t *fifo, void *buffer, size_t size)
+{
+    fifo->buffer = buffer;
+    fifo->size = size;
+    fifo->head = 0;
+    fifo->tail = 0;
+}
+
+size_t bc_fifo_write(bc_fifo_t *fifo, const void *buffer, size_t length)
+{
+    const uint8_t *data = buffer;
+    size_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        size_t next = (fifo->head + 1) % fifo->size;
+
+        if (next == fifo->tail)
+        {
+            break;
+        }
+
+        ((uint8_t *) fifo->buffer)[fifo->head] = data[i];
+        fifo->head = next;
+    }
+
+    return i;
+}
+
+size_t bc_fifo_read(bc_fifo_t *fifo, void *buffer, size_t length)
+{
+    uint8_t *data = buffer;
+    size_t i;
+
+    for (i = 0; (i < length) && (fifo->tail != fifo->head); i++)
+    {
+        data[i] = ((uint8_t *) fifo->buffer)[fifo->tail];
+        fifo->tail = (fifo->tail + 1) % fifo->size;
+    }
+
+    return i;
+}
+
+static size_t _bc_io_read(void *buffer, size_t length)
+{
+    uint8_t *data = buffer;
+    size_t i;
+
+    for (i = 0; (i < length) && (_bc_io.tail != _bc_io.head); i++)
+    {
+        data[i] = _bc_io.buffer[_bc_io.tail];
+        _bc_io.tail = (_bc_io.tail + 1) % HOST_INPUT_SIZE;
+    }
+
+    return i;
+}
+
+static bool _bc_io_write(const void *buffer, size_t length)
+{
+    const uint8_t *data = buffer;
+
+    while (length > 0)
+    {
+        ssize_t written = write(STDOUT_FILENO, data, length);
+
+        if (written <= 0)
+        {
+            return false;
+        }
+
+        data += written;
+        length -= (size_t) written;
+    }
+
+    return true;
+}
+
+static void _bc_io_uart_task(void *param)
+{
+    (void) param;
+
+    if (host_input_pending() && (_bc_io.uart_event_handler != NULL))
+    {
+        _bc_io.uart_event_handler(_bc_io.uart_channel, BC_UART_EVENT_ASYNC_READ_DATA, _bc_io.uart_event_param);
+    }
+}
@@ -0,0 +1,465 @@
+#include <bcl.h>
+#include <host.h>
+
+#define BC_RADIO_HOST_MY_ID 0x836d19800000ULL
+
+// Pairing state as the gateway radio keeps it, the air side is the host_radio_* calls
+static struct
+{
+    bc_radio_mode_t mode;
+    void (*event_handler)(bc_radio_event_t, void *);
+    void *event_param;
+    uint64_t event_id;
+    uint64_t peer_id[BC_RADIO_MAX_DEVICES];
+    bc_scheduler_task_id_t init_task_id;
+
+} _bc_radio;
+
+static void _bc_radio_init_task(void *param);
+static void _bc_radio_log(const char *format, ...);
+static bool _bc_radio_parse_id(const char **line, uint64_t *id);
+static bool _bc_radio_parse_word(const char **line, char *word, size_t size);
+
+void bc_radio_init(bc_radio_mode_t mode)
+{
+    memset(&_bc_radio, 0, sizeof(_bc_radio));
+
+    _bc_radio.mode = mode;
+
+    // The SDK reports INIT_DONE from its own task once the transceiver is up
+    _bc_radio.init_task_id = bc_scheduler_register(_bc_radio_init_task, NULL, 0);
+}
+
+void bc_radio_set_event_handler(void (*event_handler)(bc_radio_event_t, void *), void *event_param)
+{
+    _bc_radio.event_handler = event_handler;
+    _bc_radio.event_param = event_param;
+}
+
+uint64_t bc_radio_get_event_id(void)
+{
+    return _bc_radio.event_id;
+}
+
+uint64_t bc_radio_get_my_id(void)
+{
+    return BC_RADIO_HOST_MY_ID;
+}
+
+void bc_radio_get_peer_id(uint64_t *peer_id, int length)
+{
+    for (int i = 0; (i < length) && (i < BC_RADIO_MAX_DEVICES); i++)
+    {
+        peer_id[i] = _bc_radio.peer_id[i];
+    }
+}
+
+bool bc_radio_peer_device_add(uint64_t id)
+{
+    if (bc_radio_is_peer_device(id))
+    {
+        return true;
+    }
+
+    for (int i = 0; i < BC_RADIO_MAX_DEVICES; i++)
+    {
+        if (_bc_radio.peer_id[i] == 0)
+        {
+            _bc_radio.peer_id[i] = id;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool bc_radio_peer_device_remove(uint64_t id)
+{
+    for (int i = 0; i < BC_RADIO_MAX_DEVICES; i++)
+    {
+        if (_bc_radio.peer_id[i] == id)
+        {
+            _bc_radio.peer_id[i] = 0;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool bc_radio_peer_device_purge_all(void)
+{
+    memset(_bc_radio.peer_id, 0, sizeof(_bc_radio.peer_id));
+
+    return true;
+}
+
+bool bc_radio_is_peer_device(uint64_t id)
+{
+    for (int i = 0; i < BC_RADIO_MAX_DEVICES; i++)
+    {
+        if ((id != 0) && (_bc_radio.peer_id[i] == id))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void bc_radio_scan_start(void)
+{
+    _bc_radio_log("scan-start");
+}
+
+void bc_radio_scan_stop(void)
+{
+    _bc_radio_log("scan-stop");
+}
+
+void bc_radio_pairing_mode_start(void)
+{
+    _bc_radio_log("pairing-mode-start");
+}
+
+void bc_radio_pairing_mode_stop(void)
+{
+    _bc_radio_log("pairing-mode-stop");
+}
+
+void bc_radio_automatic_pairing_start(void)
+{
+    _bc_radio_log("automatic-pairing-start");
+}
+
+void bc_radio_automatic_pairing_stop(void)
+{
+    _bc_radio_log("automatic-pairing-stop");
+}
+
+bool bc_radio_pub_buffer(void *buffer, size_t length)
+{
+    char hex[2 * BC_RADIO_MAX_BUFFER_SIZE + 1];
+    size_t i;
+
+    for (i = 0; (i < length) && (i < BC_RADIO_MAX_BUFFER_SIZE); i++)
+    {
+        snprintf(hex + 2 * i, 3, "%02x", ((uint8_t *) buffer)[i]);
+    }
+
+    hex[2 * i] = 0;
+
+    _bc_radio_log("buffer %s", hex);
+
+    return true;
+}
+
+bool bc_radio_node_state_set(uint64_t *id, uint8_t state_id, bool *state)
+{
+    _bc_radio_log("state-set %012" PRIx64 " %u %s", *id, state_id, state == NULL ? "null" : *state ? "true" : "false");
+
+    return true;
+}
+
+bool bc_radio_node_state_get(uint64_t *id, uint8_t state_id)
+{
+    _bc_radio_log("state-get %012" PRIx64 " %u", *id, state_id);
+
+    return true;
+}
+
+bool bc_radio_node_led_strip_color_set(uint64_t *id, uint32_t color)
+{
+    _bc_radio_log("led-strip-color-set %012" PRIx64 " %08" PRIx32, *id, color);
+
+    return true;
+}
+
+bool bc_radio_node_led_strip_brightness_set(uint64_t *id, uint8_t brightness)
+{
+    _bc_radio_log("led-strip-brightness-set %012" PRIx64 " %u", *id, brightness);
+
+    return true;
+}
+
+bool bc_radio_node_led_strip_compound_set(uint64_t *id, uint8_t *compound, size_t length)
+{
+    (void) compound;
+
+    _bc_radio_log("led-strip-compound-set %012" PRIx64 " %zu", *id, length);
+
+    return true;
+}
+
+bool bc_radio_node_led_strip_effect_set(uint64_t *id, bc_radio_node_led_strip_effect_t type, uint16_t wait, uint32_t color)
+{
+    _bc_radio_log("led-strip-effect-set %012" PRIx64 " %d %u %08" PRIx32, *id, (int) type, wait, color);
+
+    return true;
+}
+
+bool bc_radio_node_led_strip_thermometer_set(uint64_t *id, float temperature, int8_t min, int8_t max, uint8_t white_dots, float *set_point, uint32_t color)
+{
+    (void) set_point;
+
+    _bc_radio_log("led-strip-thermometer-set %012" PRIx64 " %.2f %d %d %u %08" PRIx32, *id, temperature, min, max, white_dots, color);
+
+    return true;
+}
+
+void host_radio_event(int event, uint64_t id)
+{
+    if (event == BC_RADIO_EVENT_ATTACH)
+    {
+        if (!bc_radio_peer_device_add(id))
+        {
+            event = BC_RADIO_EVENT_ATTACH_FAILURE;
+        }
+    }
+    else if (event == BC_RADIO_EVENT_DETACH)
+    {
+        bc_radio_peer_device_remove(id);
+    }
+
+    _bc_radio.event_id = id;
+
+    if (_bc_radio.event_handler != NULL)
+    {
+        _bc_radio.event_handler((bc_radio_event_t) event, _bc_radio.event_param);
+    }
+}
+
+// One packet per line, for example "temperature 836d19833a1b 0x80 21.5"
+bool host_radio_command(const char *line)
+{
+    char name[24];
+    char word[64];
+    uint64_t id;
+
+    if (!_bc_radio_parse_word(&line, name, sizeof(name)) || !_bc_radio_parse_id(&line, &id))
+    {
+        return false;
+    }
+
+    if (strcmp(name, "attach") == 0)
+    {
+        host_radio_event(BC_RADIO_EVENT_ATTACH, id);
+
+        return true;
+    }
+
+    if (strcmp(name, "detach") == 0)
+    {
+        host_radio_event(BC_RADIO_EVENT_DETACH, id);
+
+        return true;
+    }
+
+    if (strcmp(name, "found") == 0)
+    {
+        host_radio_event(BC_RADIO_EVENT_SCAN_FIND_DEVICE, id);
+
+        return true;
+    }
+
+    // The SDK drops packets from devices that are not paired
+    if (!bc_radio_is_peer_device(id))
+    {
+        fprintf(stderr, "host: %012" PRIx64 " is not paired\n", id);
+
+        return true;
+    }
+
+    char *end;
+
+    if (strcmp(name, "info") == 0)
+    {
+        char firmware[32];
+        char version[32];
+
+        if (!_bc_radio_parse_word(&line, firmware, sizeof(firmware)) || !_bc_radio_parse_word(&line, version, sizeof(version)))
+        {
+            return false;
+        }
+
+        bc_radio_on_info(&id, firmware, version);
+    }
+    else if ((strcmp(name, "temperature") == 0) || (strcmp(name, "humidity") == 0) || (strcmp(name, "lux-meter") == 0) || (strcmp(name, "barometer") == 0))
+    {
+        uint8_t channel = (uint8_t) strtoul(line, &end, 0);
+        float value = strtof(end, &end);
+
+        if (end == line)
+        {
+            return false;
+        }
+
+        if (name[0] == 't')
+        {
+            bc_radio_pub_on_temperature(&id, channel, &value);
+        }
+        else if (name[0] == 'h')
+        {
+            bc_radio_pub_on_humidity(&id, channel, &value);
+        }
+        else if (name[0] == 'l')
+        {
+            bc_radio_pub_on_lux_meter(&id, channel, &value);
+        }
+        else
+        {
+            float altitude = strtof(end, &end);
+
+            bc_radio_pub_on_barometer(&id, channel, &value, &altitude);
+        }
+    }
+    else if ((strcmp(name, "co2") == 0) || (strcmp(name, "battery") == 0))
+    {
+        float value = strtof(line, &end);
+
+        if (end == line)
+        {
+            return false;
+        }
+
+        if (name[0] == 'c')
+        {
+            bc_radio_pub_on_co2(&id, &value);
+        }
+        else
+        {
+            bc_radio_pub_on_battery(&id, &value);
+        }
+    }
+    else if (strcmp(name, "event-count") == 0)
+    {
+        uint8_t event_id = (uint8_t) strtoul(line, &end, 0);
+        uint16_t count = (uint16_t) strtoul(end, &end, 0);
+
+        bc_radio_pub_on_event_count(&id, event_id, &count);
+    }
+    else if (strcmp(name, "state") == 0)
+    {
+        uint8_t state_id = (uint8_t) strtoul(line, &end, 0);
+        line = end;
+
+        if (!_bc_radio_parse_word(&line, word, sizeof(word)))
+        {
+            return false;
+        }
+
+        bool state = strcmp(word, "true") == 0;
+
+        bc_radio_pub_on_state(&id, state_id, strcmp(word, "null") == 0 ? NULL : &state);
+    }
+    else if ((strcmp(name, "bool") == 0) || (strcmp(name, "int") == 0) || (strcmp(name, "float") == 0))
+    {
+        if (!_bc_radio_parse_word(&line, word, sizeof(word)))
+        {
+            return false;
+        }
+
+        if (name[0] == 'b')
+        {
+            bool value = strncmp(line + strspn(line, " "), "true", 4) == 0;
+
+            bc_radio_pub_on_bool(&id, word, &value);
+        }
+        else if (name[0] == 'i')
+        {
+            int value = (int) strtol(line, NULL, 0);
+
+            bc_radio_pub_on_int(&id, word, &value);
+        }
+        else
+        {
+            float value = strtof(line, NULL);
+
+            bc_radio_pub_on_float(&id, word, &value);
+        }
+    }
+    else if (strcmp(name, "buffer") == 0)
+    {
+        uint8_t buffer[BC_RADIO_MAX_BUFFER_SIZE];
+        size_t length = 0;
+
+        if (!_bc_radio_parse_word(&line, word, sizeof(word)))
+        {
+            return false;
+        }
+
+        for (const char *hex = word; (hex[0] != 0) && (hex[1] != 0) && (length < sizeof(buffer)); hex += 2)
+        {
+            char byte[3] = { hex[0], hex[1], 0 };
+
+            buffer[length++] = (uint8_t) strtoul(byte, NULL, 16);
+        }
+
+        bc_radio_pub_on_buffer(&id, buffer, length);
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+static void _bc_radio_init_task(void *param)
+{
+    (void) param;
+
+    bc_scheduler_unregister(_bc_radio.init_task_id);
+
+    host_radio_event(BC_RADIO_EVENT_INIT_DONE, 0);
+}
+
+static void _bc_radio_log(const char *format, ...)
+{
+    va_list ap;
+
+    fprintf(stderr, "radio: ");
+
+    va_start(ap, format);
+    vfprintf(stderr, format, ap);
+    va_end(ap);
+
+    fprintf(stderr, "\n");
+}
+
+static bool _bc_radio_parse_id(const char **line, uint64_t *id)
+{
+    char word[17];
+
+    if (!_bc_radio_parse_word(line, word, sizeof(word)))
+    {
+        return false;
+    }
+
+    char *end;
+
+    *id = strtoull(word, &end, 16);
+
+    return *end == 0;
+}
+
+static bool _bc_radio_parse_word(const char **line, char *word, size_t size)
+{
+    const char *start = *line + strspn(*line, " \t");
+    size_t length = strcspn(start, " \t\r\n");
+
+    if ((length == 0) || (length >= size))
+    {
+        return false;
+    }
+
+    memcpy(word, start, length);
+
+    word[length] = 0;
+
+    *line = start + length;
+
+    return true;
+}
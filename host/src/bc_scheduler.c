@@ -0,0 +1,131 @@
+#include <bc_scheduler.h>
+
+// Same rules as the SDK scheduler: tasks run in id order, a task is unplanned before it runs
+// and sleeps unless it plans itself again
+static struct
+{
+    struct
+    {
+        bc_tick_t tick_execution;
+        void (*task)(void *);
+        void *param;
+
+    } pool[BC_SCHEDULER_MAX_TASKS];
+
+    bc_scheduler_task_id_t max_task_id;
+    bc_scheduler_task_id_t current_task_id;
+    bc_tick_t tick_spin;
+
+} _bc_scheduler;
+
+void bc_scheduler_init(void)
+{
+    memset(&_bc_scheduler, 0, sizeof(_bc_scheduler));
+}
+
+bc_tick_t bc_scheduler_run_once(size_t *count)
+{
+    bc_tick_t next = BC_TICK_INFINITY;
+
+    *count = 0;
+
+    _bc_scheduler.tick_spin = bc_tick_get();
+
+    for (_bc_scheduler.current_task_id = 0; _bc_scheduler.current_task_id <= _bc_scheduler.max_task_id; _bc_scheduler.current_task_id++)
+    {
+        bc_scheduler_task_id_t id = _bc_scheduler.current_task_id;
+
+        if (_bc_scheduler.pool[id].task == NULL)
+        {
+            continue;
+        }
+
+        if (_bc_scheduler.tick_spin >= _bc_scheduler.pool[id].tick_execution)
+        {
+            _bc_scheduler.pool[id].tick_execution = BC_TICK_INFINITY;
+
+            _bc_scheduler.pool[id].task(_bc_scheduler.pool[id].param);
+
+            (*count)++;
+        }
+    }
+
+    for (bc_scheduler_task_id_t id = 0; id <= _bc_scheduler.max_task_id; id++)
+    {
+        if ((_bc_scheduler.pool[id].task != NULL) && (_bc_scheduler.pool[id].tick_execution < next))
+        {
+            next = _bc_scheduler.pool[id].tick_execution;
+        }
+    }
+
+    return next;
+}
+
+bc_scheduler_task_id_t bc_scheduler_register(void (*task)(void *), void *param, bc_tick_t tick)
+{
+    for (bc_scheduler_task_id_t id = 0; id < BC_SCHEDULER_MAX_TASKS; id++)
+    {
+        if (_bc_scheduler.pool[id].task == NULL)
+        {
+            _bc_scheduler.pool[id].task = task;
+            _bc_scheduler.pool[id].param = param;
+            _bc_scheduler.pool[id].tick_execution = tick;
+
+            if (id > _bc_scheduler.max_task_id)
+            {
+                _bc_scheduler.max_task_id = id;
+            }
+
+            return id;
+        }
+    }
+
+    fprintf(stderr, "host: scheduler is full\n");
+
+    abort();
+}
+
+void bc_scheduler_unregister(bc_scheduler_task_id_t task_id)
+{
+    _bc_scheduler.pool[task_id].task = NULL;
+}
+
+bc_scheduler_task_id_t bc_scheduler_get_current_task_id(void)
+{
+    return _bc_scheduler.current_task_id;
+}
+
+bc_tick_t bc_scheduler_get_spin_tick(void)
+{
+    return _bc_scheduler.tick_spin;
+}
+
+void bc_scheduler_plan_now(bc_scheduler_task_id_t task_id)
+{
+    _bc_scheduler.pool[task_id].tick_execution = 0;
+}
+
+void bc_scheduler_plan_absolute(bc_scheduler_task_id_t task_id, bc_tick_t tick)
+{
+    _bc_scheduler.pool[task_id].tick_execution = tick;
+}
+
+void bc_scheduler_plan_relative(bc_scheduler_task_id_t task_id, bc_tick_t tick)
+{
+    _bc_scheduler.pool[task_id].tick_execution = _bc_scheduler.tick_spin + tick;
+}
+
+void bc_scheduler_plan_current_now(void)
+{
+    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = 0;
+}
+
+void bc_scheduler_plan_current_absolute(bc_tick_t tick)
+{
+    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = tick;
+}
+
+void bc_scheduler_plan_current_relative(bc_tick_t tick)
+{
+    _bc_scheduler.pool[_bc_scheduler.current_task_id].tick_execution = _bc_scheduler.tick_spin + tick;
+}
@@ -0,0 +1,46 @@
+#include <bc_tick.h>
+#include <bc_timer.h>
+#include <time.h>
+
+static uint64_t _bc_tick_now_us(void)
+{
+    static uint64_t start;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    uint64_t us = (uint64_t) now.tv_sec * 1000000 + (uint64_t) now.tv_nsec / 1000;
+
+    if (start == 0)
+    {
+        start = us;
+    }
+
+    return us - start;
+}
+
+bc_tick_t bc_tick_get(void)
+{
+    return _bc_tick_now_us() / 1000;
+}
+
+static uint64_t _bc_timer_start;
+
+void bc_timer_init(void)
+{
+}
+
+void bc_timer_start(void)
+{
+    _bc_timer_start = _bc_tick_now_us();
+}
+
+// Wraps like the 16-bit hardware counter
+uint16_t bc_timer_get_microseconds(void)
+{
+    return (uint16_t) (_bc_tick_now_us() - _bc_timer_start);
+}
+
+void bc_timer_stop(void)
+{
+}
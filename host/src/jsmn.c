@@ -0,0 +1,338 @@
+#include <jsmn.h>
+#include <ctype.h>
+
+// Non-strict jsmn as the SDK builds it, without parent links
+
+static jsmntok_t *_jsmn_alloc_token(jsmn_parser *parser, jsmntok_t *tokens, size_t num_tokens);
+static int _jsmn_parse_primitive(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, size_t num_tokens);
+static int _jsmn_parse_string(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, size_t num_tokens);
+
+void jsmn_init(jsmn_parser *parser)
+{
+    parser->pos = 0;
+    parser->toknext = 0;
+    parser->toksuper = -1;
+}
+
+int jsmn_parse(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, unsigned int num_tokens)
+{
+    int r;
+    int i;
+    jsmntok_t *token;
+    int count = parser->toknext;
+
+    for (; (parser->pos < len) && (js[parser->pos] != '\0'); parser->pos++)
+    {
+        char c = js[parser->pos];
+        jsmntype_t type;
+
+        switch (c)
+        {
+            case '{':
+            case '[':
+            {
+                count++;
+
+                if (tokens == NULL)
+                {
+                    break;
+                }
+
+                token = _jsmn_alloc_token(parser, tokens, num_tokens);
+
+                if (token == NULL)
+                {
+                    return JSMN_ERROR_NOMEM;
+                }
+
+                if (parser->toksuper != -1)
+                {
+                    tokens[parser->toksuper].size++;
+                }
+
+                token->type = c == '{' ? JSMN_OBJECT : JSMN_ARRAY;
+                token->start = (int) parser->pos;
+                parser->toksuper = (int) parser->toknext - 1;
+
+                break;
+            }
+            case '}':
+            case ']':
+            {
+                if (tokens == NULL)
+                {
+                    break;
+                }
+
+                type = c == '}' ? JSMN_OBJECT : JSMN_ARRAY;
+
+                for (i = (int) parser->toknext - 1; i >= 0; i--)
+                {
+                    token = &tokens[i];
+
+                    if ((token->start != -1) && (token->end == -1))
+                    {
+                        if (token->type != type)
+                        {
+                            return JSMN_ERROR_INVAL;
+                        }
+
+                        parser->toksuper = -1;
+                        token->end = (int) parser->pos + 1;
+
+                        break;
+                    }
+                }
+
+                if (i == -1)
+                {
+                    return JSMN_ERROR_INVAL;
+                }
+
+                for (; i >= 0; i--)
+                {
+                    token = &tokens[i];
+
+                    if ((token->start != -1) && (token->end == -1))
+                    {
+                        parser->toksuper = i;
+
+                        break;
+                    }
+                }
+
+                break;
+            }
+            case '"':
+            {
+                r = _jsmn_parse_string(parser, js, len, tokens, num_tokens);
+
+                if (r < 0)
+                {
+                    return r;
+                }
+
+                count++;
+
+                if ((parser->toksuper != -1) && (tokens != NULL))
+                {
+                    tokens[parser->toksuper].size++;
+                }
+
+                break;
+            }
+            case '\t':
+            case '\r':
+            case '\n':
+            case ' ':
+            {
+                break;
+            }
+            case ':':
+            {
+                parser->toksuper = (int) parser->toknext - 1;
+
+                break;
+            }
+            case ',':
+            {
+                if ((tokens != NULL) && (parser->toksuper != -1) &&
+                        (tokens[parser->toksuper].type != JSMN_ARRAY) && (tokens[parser->toksuper].type != JSMN_OBJECT))
+                {
+                    for (i = (int) parser->toknext - 1; i >= 0; i--)
+                    {
+                        if ((tokens[i].type == JSMN_ARRAY) || (tokens[i].type == JSMN_OBJECT))
+                        {
+                            if ((tokens[i].start != -1) && (tokens[i].end == -1))
+                            {
+                                parser->toksuper = i;
+
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                break;
+            }
+            default:
+            {
+                r = _jsmn_parse_primitive(parser, js, len, tokens, num_tokens);
+
+                if (r < 0)
+                {
+                    return r;
+                }
+
+                count++;
+
+                if ((parser->toksuper != -1) && (tokens != NULL))
+                {
+                    tokens[parser->toksuper].size++;
+                }
+
+                break;
+            }
+        }
+    }
+
+    if (tokens != NULL)
+    {
+        for (i = (int) parser->toknext - 1; i >= 0; i--)
+        {
+            if ((tokens[i].start != -1) && (tokens[i].end == -1))
+            {
+                return JSMN_ERROR_PART;
+            }
+        }
+    }
+
+    return count;
+}
+
+static jsmntok_t *_jsmn_alloc_token(jsmn_parser *parser, jsmntok_t *tokens, size_t num_tokens)
+{
+    if (parser->toknext >= num_tokens)
+    {
+        return NULL;
+    }
+
+    jsmntok_t *token = &tokens[parser->toknext++];
+
+    token->start = -1;
+    token->end = -1;
+    token->size = 0;
+
+    return token;
+}
+
+static int _jsmn_parse_primitive(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, size_t num_tokens)
+{
+    int start = (int) parser->pos;
+
+    for (; (parser->pos < len) && (js[parser->pos] != '\0'); parser->pos++)
+    {
+        char c = js[parser->pos];
+
+        if ((c == ':') || (c == '\t') || (c == '\r') || (c == '\n') || (c == ' ') || (c == ',') || (c == ']') || (c == '}'))
+        {
+            break;
+        }
+
+        if ((c < 32) || (c >= 127))
+        {
+            parser->pos = (unsigned int) start;
+
+            return JSMN_ERROR_INVAL;
+        }
+    }
+
+    if (tokens == NULL)
+    {
+        parser->pos--;
+
+        return 0;
+    }
+
+    jsmntok_t *token = _jsmn_alloc_token(parser, tokens, num_tokens);
+
+    if (token == NULL)
+    {
+        parser->pos = (unsigned int) start;
+
+        return JSMN_ERROR_NOMEM;
+    }
+
+    token->type = JSMN_PRIMITIVE;
+    token->start = start;
+    token->end = (int) parser->pos;
+
+    parser->pos--;
+
+    return 0;
+}
+
+static int _jsmn_parse_string(jsmn_parser *parser, const char *js, size_t len, jsmntok_t *tokens, size_t num_tokens)
+{
+    int start = (int) parser->pos;
+
+    parser->pos++;
+
+    for (; (parser->pos < len) && (js[parser->pos] != '\0'); parser->pos++)
+    {
+        char c = js[parser->pos];
+
+        if (c == '"')
+        {
+            if (tokens == NULL)
+            {
+                return 0;
+            }
+
+            jsmntok_t *token = _jsmn_alloc_token(parser, tokens, num_tokens);
+
+            if (token == NULL)
+            {
+                parser->pos = (unsigned int) start;
+
+                return JSMN_ERROR_NOMEM;
+            }
+
+            token->type = JSMN_STRING;
+            token->start = start + 1;
+            token->end = (int) parser->pos;
+
+            return 0;
+        }
+
+        if ((c == '\\') && (parser->pos + 1 < len))
+        {
+            parser->pos++;
+
+            switch (js[parser->pos])
+            {
+                case '"':
+                case '/':
+                case '\\':
+                case 'b':
+                case 'f':
+                case 'r':
+                case 'n':
+                case 't':
+                {
+                    break;
+                }
+                case 'u':
+                {
+                    parser->pos++;
+
+                    for (int i = 0; (i < 4) && (parser->pos < len) && (js[parser->pos] != '\0'); i++)
+                    {
+                        if (!isxdigit((unsigned char) js[parser->pos]))
+                        {
+                            parser->pos = (unsigned int) start;
+
+                            return JSMN_ERROR_INVAL;
+                        }
+
+                        parser->pos++;
+                    }
+
+                    parser->pos--;
+
+                    break;
+                }
+                default:
+                {
+                    parser->pos = (unsigned int) start;
+
+                    return JSMN_ERROR_INVAL;
+                }
+            }
+        }
+    }
+
+    parser->pos = (unsigned int) start;
+
+    return JSMN_ERROR_PART;
+}
@@ -0,0 +1,286 @@
+#include <bcl.h>
+#include <host.h>
+#include <ucontext.h>
+#include <sys/select.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define HOST_SRAM_SIZE (256 * 1024)
+#define HOST_LINE_SIZE 2048
+#define HOST_QUEUE_SIZE (4 * HOST_LINE_SIZE)
+#define HOST_IDLE_SPINS 1000
+#define HOST_LINGER 200
+
+#define HOST_STRING(x) HOST_STRING_(x)
+#define HOST_STRING_(x) #x
+
+// The firmware runs on its own stack inside this array and the linker symbols ram.c reads
+// point into it, so /memory/get paints and measures a real stack. There is no separate
+// .data or .bss in here, both read as empty. The host linker script defines _edata itself,
+// make host pins _sdata to it with --defsym.
+uint32_t _host_sram[HOST_SRAM_SIZE / sizeof(uint32_t)] __attribute__((aligned(16)));
+
+__asm__(
+    ".globl _sbss\n.set _sbss, _host_sram\n"
+    ".globl _ebss\n.set _ebss, _host_sram\n"
+    ".globl _estack\n.set _estack, _host_sram + " HOST_STRING(HOST_SRAM_SIZE) "\n");
+
+static struct
+{
+    ucontext_t main_context;
+    ucontext_t firmware_context;
+
+    // stdin as read, a line leaves only once the firmware consumed the one before it,
+    // so radio packets and usb_talk messages keep their order
+    char queue[HOST_QUEUE_SIZE];
+    size_t queue_length;
+    bool eof;
+    bc_tick_t eof_tick;
+    bc_tick_t linger;
+    int idle;
+
+} _host;
+
+static void _host_firmware(void);
+static void _host_application_task(void *param);
+static bool _host_wait(bc_tick_t next, bool busy);
+static bool _host_dispatch(void);
+static void _host_line(const char *line, size_t length);
+
+__attribute__((weak)) void application_task(void)
+{
+}
+
+int main(int argc, char *argv[])
+{
+    int option;
+
+    _host.linger = HOST_LINGER;
+
+    while ((option = getopt(argc, argv, "e:l:h")) != -1)
+    {
+        switch (option)
+        {
+            case 'e':
+            {
+                host_eeprom_set_file(optarg);
+
+                break;
+            }
+            case 'l':
+            {
+                _host.linger = strtoull(optarg, NULL, 10);
+
+                break;
+            }
+            default:
+            {
+                fprintf(stderr, "usage: %s [-e eeprom.bin] [-l linger-ms]\n"
+                        "  stdin lines go to usb_talk, lines starting with ! are radio packets, see README.md\n", argv[0]);
+
+                return option == 'h' ? 0 : 1;
+            }
+        }
+    }
+
+    getcontext(&_host.firmware_context);
+
+    _host.firmware_context.uc_stack.ss_sp = _host_sram;
+    _host.firmware_context.uc_stack.ss_size = sizeof(_host_sram);
+    _host.firmware_context.uc_link = &_host.main_context;
+
+    makecontext(&_host.firmware_context, _host_firmware, 0);
+
+    swapcontext(&_host.main_context, &_host.firmware_context);
+
+    return 0;
+}
+
+static void _host_firmware(void)
+{
+    size_t count;
+
+    bc_scheduler_init();
+
+    // Task 0 like in the SDK, the application plans it with APPLICATION_TASK_ID
+    bc_scheduler_register(_host_application_task, NULL, 0);
+
+    application_init();
+
+    do
+    {
+        bc_tick_t next = bc_scheduler_run_once(&count);
+
+        // The USB CDC reader replans itself on every spin, anything beyond it counts as work
+        if (count > 1)
+        {
+            _host.idle = 0;
+        }
+
+        if (!_host_wait(next, count > 1))
+        {
+            break;
+        }
+    }
+    while (true);
+}
+
+static void _host_application_task(void *param)
+{
+    (void) param;
+
+    application_task();
+}
+
+// Waits for stdin until the next task is due, false once stdin is closed and the firmware had time to settle
+static bool _host_wait(bc_tick_t next, bool busy)
+{
+    if (_host_dispatch())
+    {
+        _host.idle = 0;
+
+        return true;
+    }
+
+    bc_tick_t now = bc_tick_get();
+    struct timeval timeout = { 0, 0 };
+    struct timeval *wait = &timeout;
+
+    if (_host.eof)
+    {
+        if (!busy && !host_input_pending() && (_host.queue_length == 0) && (now >= _host.eof_tick + _host.linger))
+        {
+            return false;
+        }
+
+        if (next > now)
+        {
+            bc_tick_t ms = next - now < 10 ? next - now : 10;
+
+            timeout.tv_usec = (suseconds_t) (ms * 1000);
+
+            select(0, NULL, NULL, NULL, &timeout);
+        }
+
+        return true;
+    }
+
+    // While the firmware still reads the last line stdin is only polled
+    if (host_input_pending())
+    {
+        _host.idle = 0;
+    }
+    else if (next == BC_TICK_INFINITY)
+    {
+        wait = NULL;
+    }
+    else if (next > now)
+    {
+        timeout.tv_sec = (time_t) ((next - now) / 1000);
+        timeout.tv_usec = (suseconds_t) (((next - now) % 1000) * 1000);
+    }
+    else if (++_host.idle > HOST_IDLE_SPINS)
+    {
+        // Only the CDC reader keeps spinning, give the CPU back for a millisecond
+        timeout.tv_usec = 1000;
+    }
+
+    // A full queue holds one more line than fits, stop reading until it drains
+    if (_host.queue_length == sizeof(_host.queue))
+    {
+        select(0, NULL, NULL, NULL, &timeout);
+
+        return true;
+    }
+
+    fd_set set;
+
+    FD_ZERO(&set);
+    FD_SET(STDIN_FILENO, &set);
+
+    int ready = select(STDIN_FILENO + 1, &set, NULL, NULL, wait);
+
+    if ((ready < 0) && (errno != EINTR))
+    {
+        return false;
+    }
+
+    if ((ready <= 0) || !FD_ISSET(STDIN_FILENO, &set))
+    {
+        return true;
+    }
+
+    ssize_t length = read(STDIN_FILENO, _host.queue + _host.queue_length, sizeof(_host.queue) - _host.queue_length);
+
+    if (length <= 0)
+    {
+        _host.eof = true;
+        _host.eof_tick = bc_tick_get();
+
+        return true;
+    }
+
+    _host.queue_length += (size_t) length;
+    _host.idle = 0;
+
+    return true;
+}
+
+// Hands the next queued line over once the firmware is done with the previous one, true when it did
+static bool _host_dispatch(void)
+{
+    if ((_host.queue_length == 0) || host_input_pending())
+    {
+        return false;
+    }
+
+    char *end = memchr(_host.queue, '\n', _host.queue_length);
+    size_t length;
+
+    if (end != NULL)
+    {
+        length = (size_t) (end - _host.queue) + 1;
+    }
+    else if (_host.eof || (_host.queue_length >= HOST_LINE_SIZE))
+    {
+        length = _host.queue_length;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (length > HOST_LINE_SIZE)
+    {
+        length = HOST_LINE_SIZE;
+    }
+
+    _host_line(_host.queue, length);
+
+    _host.queue_length -= length;
+
+    memmove(_host.queue, _host.queue + length, _host.queue_length);
+
+    return true;
+}
+
+static void _host_line(const char *line, size_t length)
+{
+    if (line[0] != '!')
+    {
+        host_input_push(line, length);
+
+        return;
+    }
+
+    char command[HOST_LINE_SIZE];
+
+    memcpy(command, line + 1, length - 1);
+
+    command[length - 1] = 0;
+
+    if (!host_radio_command(command))
+    {
+        fprintf(stderr, "host: cannot parse %s", command);
+    }
+}
@@ -0,0 +1,200 @@
+#include <compound.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TEST_COMPOUND_SIZE 1000
+#define TEST_PACKED_SIZE 512
+#define TEST_LED_COUNT (255 * (TEST_COMPOUND_SIZE / COMPOUND_TUPLE_SIZE))
+#define TEST_RANDOM_CASES 2000
+
+static struct
+{
+    uint8_t compound[TEST_COMPOUND_SIZE];
+    uint8_t packed[TEST_PACKED_SIZE];
+    uint8_t decoded[TEST_COMPOUND_SIZE];
+    uint8_t expected[TEST_LED_COUNT * 4];
+    uint8_t actual[TEST_LED_COUNT * 4];
+    uint32_t random;
+    int cases;
+    int failures;
+
+} _test;
+
+static uint32_t _test_random(void);
+static size_t _test_expand(const uint8_t *compound, size_t length, uint8_t *leds);
+static void _test_round_trip(const char *name, size_t length, bool encodable);
+static size_t _test_fill_random(int palette, int tuples, bool white);
+
+int main(void)
+{
+    size_t length;
+
+    _test.random = 0x2545f491;
+
+    // One tuple, no white, the smallest packed form
+    memcpy(_test.compound, (uint8_t []) { 10, 0, 255, 0, 0 }, 5);
+    _test_round_trip("single", 5, true);
+
+    // Neighbouring tuples of one color merge into one run, runs longer than 255 split
+    for (length = 0; length < 20 * COMPOUND_TUPLE_SIZE; length += COMPOUND_TUPLE_SIZE)
+    {
+        memcpy(_test.compound + length, (uint8_t []) { 200, 0, 1, 2, 3 }, 5);
+    }
+
+    _test_round_trip("long run", length, true);
+
+    // Run lengths around the short form limit
+    for (int count = 1; count <= 17; count++)
+    {
+        memcpy(_test.compound, (uint8_t []) { (uint8_t) count, 0, 9, 8, 7, 1, 5, 1, 2, 3 }, 10);
+        _test_round_trip("short limit", 10, true);
+    }
+
+    // A gradient with the white channel uses the whole palette
+    for (int i = 0; i < COMPOUND_PALETTE_SIZE; i++)
+    {
+        memcpy(_test.compound + i * COMPOUND_TUPLE_SIZE, (uint8_t []) { 3, (uint8_t) i, (uint8_t) (i * 16), 0, (uint8_t) (255 - i * 16) }, 5);
+    }
+
+    _test_round_trip("gradient", COMPOUND_PALETTE_SIZE * COMPOUND_TUPLE_SIZE, true);
+
+    // One color more than the palette holds is refused, the caller falls back to the plain compound
+    memcpy(_test.compound + COMPOUND_PALETTE_SIZE * COMPOUND_TUPLE_SIZE, (uint8_t []) { 1, 0, 1, 1, 1 }, 5);
+    _test_round_trip("palette overflow", (COMPOUND_PALETTE_SIZE + 1) * COMPOUND_TUPLE_SIZE, false);
+
+    // Empty and broken tuples are refused
+    _test_round_trip("empty", 0, false);
+    _test_round_trip("partial tuple", 4, false);
+
+    for (int i = 0; i < TEST_RANDOM_CASES; i++)
+    {
+        int palette = 1 + _test_random() % COMPOUND_PALETTE_SIZE;
+        int tuples = 1 + _test_random() % (TEST_COMPOUND_SIZE / COMPOUND_TUPLE_SIZE / 4);
+
+        length = _test_fill_random(palette, tuples, (_test_random() & 1) != 0);
+
+        _test_round_trip("random", length, true);
+    }
+
+    printf("compound: %d cases, %d failures\n", _test.cases, _test.failures);
+
+    return _test.failures == 0 ? 0 : 1;
+}
+
+static uint32_t _test_random(void)
+{
+    // xorshift32, the same sequence on every run
+    _test.random ^= _test.random << 13;
+    _test.random ^= _test.random >> 17;
+    _test.random ^= _test.random << 5;
+
+    return _test.random;
+}
+
+// What the strip shows, tuples with the same colors in a different split are equal
+static size_t _test_expand(const uint8_t *compound, size_t length, uint8_t *leds)
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < length; i += COMPOUND_TUPLE_SIZE)
+    {
+        for (int j = 0; j < compound[i]; j++)
+        {
+            memcpy(leds + count * 4, compound + i + 1, 4);
+
+            count++;
+        }
+    }
+
+    return count;
+}
+
+static void _test_round_trip(const char *name, size_t length, bool encodable)
+{
+    size_t packed_length = sizeof(_test.packed);
+    size_t decoded_length = sizeof(_test.decoded);
+
+    _test.cases++;
+
+    if (!compound_encode(_test.compound, length, _test.packed, &packed_length))
+    {
+        if (encodable)
+        {
+            printf("compound: %s: encode failed for %zu bytes\n", name, length);
+
+            _test.failures++;
+        }
+
+        return;
+    }
+
+    if (!encodable)
+    {
+        printf("compound: %s: encode accepted %zu bytes\n", name, length);
+
+        _test.failures++;
+
+        return;
+    }
+
+    // The encoder reports exactly the space it needs, one byte less must be refused
+    size_t short_length = packed_length - 1;
+
+    if (compound_encode(_test.compound, length, _test.packed, &short_length))
+    {
+        printf("compound: %s: encode fits into %zu bytes, reported %zu\n", name, short_length, packed_length);
+
+        _test.failures++;
+
+        return;
+    }
+
+    packed_length = sizeof(_test.packed);
+
+    compound_encode(_test.compound, length, _test.packed, &packed_length);
+
+    if (!compound_decode(_test.packed, packed_length, _test.decoded, &decoded_length))
+    {
+        printf("compound: %s: decode failed for %zu packed bytes\n", name, packed_length);
+
+        _test.failures++;
+
+        return;
+    }
+
+    size_t expected = _test_expand(_test.compound, length, _test.expected);
+    size_t actual = _test_expand(_test.decoded, decoded_length, _test.actual);
+
+    if ((expected != actual) || (memcmp(_test.expected, _test.actual, expected * 4) != 0))
+    {
+        printf("compound: %s: %zu LEDs in, %zu LEDs out or colors differ\n", name, expected, actual);
+
+        _test.failures++;
+    }
+}
+
+static size_t _test_fill_random(int palette, int tuples, bool white)
+{
+    uint8_t colors[COMPOUND_PALETTE_SIZE][4];
+
+    for (int i = 0; i < palette; i++)
+    {
+        uint32_t value = _test_random();
+
+        colors[i][0] = white ? (uint8_t) (value >> 24) : 0;
+        colors[i][1] = (uint8_t) (value >> 16);
+        colors[i][2] = (uint8_t) (value >> 8);
+        colors[i][3] = (uint8_t) value;
+    }
+
+    for (int i = 0; i < tuples; i++)
+    {
+        uint8_t *tuple = _test.compound + i * COMPOUND_TUPLE_SIZE;
+
+        tuple[0] = (uint8_t) _test_random();
+
+        memcpy(tuple + 1, colors[_test_random() % palette], 4);
+    }
+
+    return tuples * COMPOUND_TUPLE_SIZE;
+}
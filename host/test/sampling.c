@@ -0,0 +1,411 @@
+#include <sampling.h>
+#include <value.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Replays value traces through fixed and adaptive sampling with the firmware publish rule,
+// built in synthetic traces run by default, recorded ones are given as pairs of type and CSV file
+// with lines of seconds,value: make host-test-sampling HOST_TEST_ARGS="temperature trace.csv"
+
+#define TEST_SECONDS_MAX (7 * 24 * 60 * 60)
+#define TEST_DAY (24 * 60 * 60)
+#define TEST_NONE -1
+
+typedef struct
+{
+    const char *name;
+    uint8_t decimals;
+    config_sensor_t config;
+
+} test_type_t;
+
+typedef struct
+{
+    int samples;
+    int publishes;
+    double error_sum;
+    double error_max;
+    int latency;
+    int off;
+    int off_max;
+
+} test_result_t;
+
+static const test_type_t _test_types[] = {
+    { "temperature", VALUE_TEMPERATURE_DECIMALS, {
+        VALUE_FIXED(TEMPERATURE_TAG_PUB_VALUE_CHANGE, VALUE_TEMPERATURE_DECIMALS), TEMPERATURE_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        TEMPERATURE_TAG_UPDATE_INTERVAL_MIN / 1000, TEMPERATURE_TAG_UPDATE_INTERVAL_MAX / 1000 } },
+    { "humidity", VALUE_HUMIDITY_DECIMALS, {
+        VALUE_FIXED(HUMIDITY_TAG_PUB_VALUE_CHANGE, VALUE_HUMIDITY_DECIMALS), HUMIDITY_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        HUMIDITY_TAG_UPDATE_INTERVAL_MIN / 1000, HUMIDITY_TAG_UPDATE_INTERVAL_MAX / 1000 } },
+    { "lux-meter", VALUE_ILLUMINANCE_DECIMALS, {
+        VALUE_FIXED(LUX_METER_TAG_PUB_VALUE_CHANGE, VALUE_ILLUMINANCE_DECIMALS), LUX_METER_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        LUX_METER_TAG_UPDATE_INTERVAL_MIN / 1000, LUX_METER_TAG_UPDATE_INTERVAL_MAX / 1000 } },
+    { "barometer", VALUE_PRESSURE_DECIMALS, {
+        VALUE_FIXED(BAROMETER_TAG_PUB_VALUE_CHANGE, VALUE_PRESSURE_DECIMALS), BAROMETER_TAG_PUB_NO_CHANGE_INTEVAL / 1000,
+        BAROMETER_TAG_UPDATE_INTERVAL_MIN / 1000, BAROMETER_TAG_UPDATE_INTERVAL_MAX / 1000 } }
+};
+
+static struct
+{
+    float trace[TEST_SECONDS_MAX];
+    int seconds;
+    uint32_t random;
+    int traces;
+    int failures;
+
+} _test;
+
+static const test_type_t *_test_type(const char *name);
+static bool _test_load(const char *path);
+static float _test_noise(float amplitude);
+static float _test_quantize(float number, float step);
+static void _test_simulate(const test_type_t *type, bool adaptive, int step, test_result_t *result);
+static void _test_replay(const char *name, const test_type_t *type, int step, bool ramp, float saving);
+
+int main(int argc, char *argv[])
+{
+    _test.random = 0x2545f491;
+
+    if (argc > 1)
+    {
+        for (int i = 1; i + 1 < argc; i += 2)
+        {
+            const test_type_t *type = _test_type(argv[i]);
+
+            if ((type == NULL) || !_test_load(argv[i + 1]))
+            {
+                printf("sampling: cannot replay %s %s\n", argv[i], argv[i + 1]);
+
+                return 1;
+            }
+
+            _test_replay(argv[i + 1], type, TEST_NONE, false, 0);
+        }
+
+        printf("sampling: %d traces, %d failures\n", _test.traces, _test.failures);
+
+        return _test.failures == 0 ? 0 : 1;
+    }
+
+    _test.seconds = TEST_DAY;
+
+    // A closed room, slow daily drift with the TMP112 flickering between neighbouring LSBs
+    for (int t = 0; t < _test.seconds; t++)
+    {
+        _test.trace[t] = _test_quantize(21.0f + 0.4f * sinf(2 * M_PI * t / TEST_DAY) + _test_noise(0.02f), 0.0625f);
+    }
+
+    _test_replay("steady room", _test_type("temperature"), TEST_NONE, true, 0.5f);
+
+    // A window opened for 20 minutes at 8:00, the room cools quickly and warms up slowly
+    for (int t = 0; t < _test.seconds; t++)
+    {
+        float number = 21.0f;
+        int opened = t - 8 * 60 * 60;
+
+        if ((opened >= 0) && (opened < 20 * 60))
+        {
+            number = 15.0f + 6.0f * expf(-opened / 300.0f);
+        }
+        else if (opened >= 20 * 60)
+        {
+            float closed = 15.0f + 6.0f * expf(-4.0f);
+
+            number = 21.0f - (21.0f - closed) * expf(-(opened - 20 * 60) / 1800.0f);
+        }
+
+        _test.trace[t] = _test_quantize(number + _test_noise(0.02f), 0.0625f);
+    }
+
+    _test_replay("window opened", _test_type("temperature"), 8 * 60 * 60, false, 0.3f);
+
+    // Radiator thermostat swinging one degree with a 40 minute period
+    for (int t = 0; t < _test.seconds; t++)
+    {
+        float phase = (float) (t % 2400) / 2400;
+
+        _test.trace[t] = _test_quantize(20.5f + (phase < 0.5f ? 2 * phase : 2 - 2 * phase) + _test_noise(0.02f), 0.0625f);
+    }
+
+    _test_replay("heating cycle", _test_type("temperature"), TEST_NONE, true, 0);
+
+    // Bathroom, a shower at 7:00 for 10 minutes
+    for (int t = 0; t < _test.seconds; t++)
+    {
+        float number = 45.0f;
+        int shower = t - 7 * 60 * 60;
+
+        if ((shower >= 0) && (shower < 10 * 60))
+        {
+            number = 85.0f - 40.0f * expf(-shower / 60.0f);
+        }
+        else if (shower >= 10 * 60)
+        {
+            number = 45.0f + 40.0f * expf(-(shower - 10 * 60) / 1800.0f);
+        }
+
+        _test.trace[t] = _test_quantize(number + _test_noise(0.2f), 0.1f);
+    }
+
+    _test_replay("shower", _test_type("humidity"), 7 * 60 * 60, false, 0.5f);
+
+    // Daylight from 6:00 to 20:00, a clear sky first and then with clouds passing around noon
+    for (int clouds = 0; clouds < 2; clouds++)
+    {
+        for (int t = 0; t < _test.seconds; t++)
+        {
+            float number = 0;
+
+            if ((t > 6 * 60 * 60) && (t < 20 * 60 * 60))
+            {
+                number = 800.0f * sinf(M_PI * (t - 6 * 60 * 60) / (14 * 60 * 60));
+
+                if (clouds && ((t / 600) % 5 == 2) && (t > 11 * 60 * 60) && (t < 14 * 60 * 60))
+                {
+                    number *= 0.4f;
+                }
+            }
+
+            _test.trace[t] = _test_quantize(number + _test_noise(1.0f), 0.1f);
+        }
+
+        _test_replay(clouds ? "clouds" : "daylight", _test_type("lux-meter"), TEST_NONE, !clouds, 0);
+    }
+
+    // Weather front, pressure falling by 15 hPa over the day
+    for (int t = 0; t < _test.seconds; t++)
+    {
+        _test.trace[t] = _test_quantize(101300.0f - 1500.0f * t / TEST_DAY + _test_noise(2.0f), 0.25f);
+    }
+
+    _test_replay("weather front", _test_type("barometer"), TEST_NONE, true, 0.5f);
+
+    printf("sampling: %d traces, %d failures\n", _test.traces, _test.failures);
+
+    return _test.failures == 0 ? 0 : 1;
+}
+
+static const test_type_t *_test_type(const char *name)
+{
+    for (size_t i = 0; i < sizeof(_test_types) / sizeof(_test_types[0]); i++)
+    {
+        if (strcmp(_test_types[i].name, name) == 0)
+        {
+            return &_test_types[i];
+        }
+    }
+
+    return NULL;
+}
+
+// Seconds count from the first line and do not have to be continuous, a value holds until the next line
+static bool _test_load(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[80];
+    int second;
+    int first = TEST_NONE;
+    float number;
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    _test.seconds = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (sscanf(line, "%d,%f", &second, &number) != 2)
+        {
+            continue;
+        }
+
+        if (first == TEST_NONE)
+        {
+            first = second;
+        }
+
+        second -= first;
+
+        if ((second < _test.seconds - 1) || (second >= TEST_SECONDS_MAX))
+        {
+            continue;
+        }
+
+        while (_test.seconds < second)
+        {
+            _test.trace[_test.seconds] = _test.trace[_test.seconds - 1];
+
+            _test.seconds++;
+        }
+
+        _test.trace[second] = number;
+        _test.seconds = second + 1;
+    }
+
+    fclose(file);
+
+    return _test.seconds > 0;
+}
+
+static float _test_noise(float amplitude)
+{
+    float sum = 0;
+
+    // xorshift32, the same traces on every run, three uniforms for a roughly normal shape
+    for (int i = 0; i < 3; i++)
+    {
+        _test.random ^= _test.random << 13;
+        _test.random ^= _test.random >> 17;
+        _test.random ^= _test.random << 5;
+
+        sum += (float) (_test.random & 0xffff) / 0xffff - 0.5f;
+    }
+
+    return sum * amplitude;
+}
+
+static float _test_quantize(float number, float step)
+{
+    return roundf(number / step) * step;
+}
+
+// One sample per due time, the publish rule of the sensors module, the error is what the host sees every second
+static void _test_simulate(const test_type_t *type, bool adaptive, int step, test_result_t *result)
+{
+    const config_sensor_t *config = &type->config;
+    double change = (double) config->value_change / VALUE_SCALE(type->decimals);
+    bc_tick_t interval = (bc_tick_t) config->interval_min * 1000;
+    bc_tick_t due = 0;
+    bc_tick_t next_pub = 0;
+    value_t published = { 0 };
+    value_t last = { 0 };
+    bool sampled = false;
+
+    memset(result, 0, sizeof(*result));
+
+    result->latency = TEST_NONE;
+
+    for (int t = 0; t < _test.seconds; t++)
+    {
+        bc_tick_t tick = (bc_tick_t) t * 1000;
+        value_t truth = value_from_float(_test.trace[t], type->decimals, VALUE_UNIT_NONE);
+
+        if (tick >= due)
+        {
+            result->samples++;
+
+            if (adaptive && sampled)
+            {
+                interval = sampling_next_interval(interval, value_distance(&truth, &last), config);
+            }
+
+            last = truth;
+            sampled = true;
+            due = tick + interval;
+
+            if ((result->publishes == 0) || (value_distance(&truth, &published) >= config->value_change) || (next_pub < tick))
+            {
+                if ((step != TEST_NONE) && (t >= step) && (result->latency == TEST_NONE))
+                {
+                    result->latency = t - step;
+                }
+
+                published = truth;
+                next_pub = tick + (bc_tick_t) config->no_change_interval * 1000;
+
+                result->publishes++;
+            }
+        }
+
+        double error = (double) value_distance(&truth, &published) / VALUE_SCALE(type->decimals);
+
+        result->error_sum += error;
+
+        if (error > result->error_max)
+        {
+            result->error_max = error;
+        }
+
+        // Off by more than two publish thresholds, a transition the host has not seen yet
+        result->off = error > 2 * change ? result->off + 1 : 0;
+
+        if (result->off > result->off_max)
+        {
+            result->off_max = result->off;
+        }
+    }
+}
+
+static void _test_replay(const char *name, const test_type_t *type, int step, bool ramp, float saving)
+{
+    test_result_t fixed;
+    test_result_t adaptive;
+    double change = (double) type->config.value_change / VALUE_SCALE(type->decimals);
+
+    _test.traces++;
+
+    _test_simulate(type, false, step, &fixed);
+    _test_simulate(type, true, step, &adaptive);
+
+    printf("sampling: %-14s fixed %6d samples %5d publishes mean error %.3f max %.3f, "
+           "adaptive %6d samples %5d publishes mean error %.3f max %.3f",
+           name, fixed.samples, fixed.publishes, fixed.error_sum / _test.seconds, fixed.error_max,
+           adaptive.samples, adaptive.publishes, adaptive.error_sum / _test.seconds, adaptive.error_max);
+
+    if (step != TEST_NONE)
+    {
+        printf(", step published after %d s", adaptive.latency);
+    }
+
+    if (adaptive.off_max > 0)
+    {
+        printf(", off for %d s", adaptive.off_max);
+    }
+
+    printf("\n");
+
+    // Never samples more, saves at least the expected share where the value is mostly still
+    if (adaptive.samples > fixed.samples - (int) (saving * fixed.samples))
+    {
+        printf("sampling: %s: adaptive sampling saves less than %.0f %%\n", name, saving * 100);
+
+        _test.failures++;
+    }
+
+    // The host may see the value late, but on average not off by more than one publish threshold
+    if (adaptive.error_sum / _test.seconds > fixed.error_sum / _test.seconds + change)
+    {
+        printf("sampling: %s: adaptive mean error exceeds the fixed one by more than %.2f\n", name, change);
+
+        _test.failures++;
+    }
+
+    // A ramp is followed sample by sample, the host is never further off than with fixed sampling plus one threshold
+    if (ramp && (adaptive.error_max > fixed.error_max + change))
+    {
+        printf("sampling: %s: adaptive max error exceeds the fixed one by more than %.2f\n", name, change);
+
+        _test.failures++;
+    }
+
+    // A transition the ramp rule cannot foresee is seen at the latest one maximum interval after it happens
+    if (adaptive.off_max > type->config.interval_max)
+    {
+        printf("sampling: %s: off for %d s, the maximum interval is %u s\n", name, adaptive.off_max, type->config.interval_max);
+
+        _test.failures++;
+    }
+
+    // A step is sampled at the latest one maximum interval after it happens
+    if ((step != TEST_NONE) && ((adaptive.latency == TEST_NONE) || (adaptive.latency > type->config.interval_max)))
+    {
+        printf("sampling: %s: step published after %d s, the maximum interval is %u s\n", name, adaptive.latency, type->config.interval_max);
+
+        _test.failures++;
+    }
+}
@@ -0,0 +1,228 @@
+#include <value.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Deadband and format path of a published value, the float one the sensors module had before
+// and the fixed point one it has now. Both have to decide and print the same, except for decisions
+// within one LSB of the threshold, the fixed path compares the rounded values the host sees,
+// and rounding at exact ties, printf rounds the binary float half to even.
+// The host has a hardware FPU, the timings only show the cost of the formatting itself,
+// on the Cortex-M0+ the float path additionally goes through soft-float.
+
+#define TEST_VALUE_COUNT 200000
+#define TEST_ROUNDS 5
+#define TEST_TEXT_LENGTH 24
+
+typedef struct
+{
+    const char *name;
+    uint8_t decimals;
+    value_unit_t unit;
+    float base;
+    float swing;
+    float step;
+    float change;
+
+} test_quantity_t;
+
+static const test_quantity_t _test_quantities[] = {
+    { "temperature", VALUE_TEMPERATURE_DECIMALS, VALUE_UNIT_CELSIUS, 21.0f, 3.0f, 0.0625f, 0.1f },
+    { "humidity", VALUE_HUMIDITY_DECIMALS, VALUE_UNIT_PERCENT, 45.0f, 20.0f, 0.0f, 1.0f },
+    { "lux-meter", VALUE_ILLUMINANCE_DECIMALS, VALUE_UNIT_LUX, 400.0f, 400.0f, 0.0f, 5.0f },
+    { "barometer", VALUE_PRESSURE_DECIMALS, VALUE_UNIT_PASCAL, 101300.0f, 800.0f, 0.25f, 10.0f }
+};
+
+static struct
+{
+    float number[TEST_VALUE_COUNT];
+    uint32_t random;
+    volatile size_t sink;
+    int failures;
+
+} _test;
+
+static float _test_random(void);
+static double _test_seconds(void);
+static int _test_float_path(const test_quantity_t *quantity);
+static int _test_fixed_path(const test_quantity_t *quantity);
+static void _test_compare(const test_quantity_t *quantity);
+
+int main(void)
+{
+    _test.random = 0x2545f491;
+
+    for (size_t i = 0; i < sizeof(_test_quantities) / sizeof(_test_quantities[0]); i++)
+    {
+        const test_quantity_t *quantity = &_test_quantities[i];
+        float number = quantity->base;
+
+        // Random walk around the base, quantized to the sensor resolution where it has one
+        for (int j = 0; j < TEST_VALUE_COUNT; j++)
+        {
+            number += _test_random() * quantity->change;
+
+            if (fabsf(number - quantity->base) > quantity->swing)
+            {
+                number = quantity->base;
+            }
+
+            _test.number[j] = quantity->step > 0 ? roundf(number / quantity->step) * quantity->step : number;
+        }
+
+        _test_compare(quantity);
+
+        double float_seconds = 0;
+        double fixed_seconds = 0;
+
+        for (int round = 0; round < TEST_ROUNDS; round++)
+        {
+            double start = _test_seconds();
+
+            _test.sink += _test_float_path(quantity);
+
+            double middle = _test_seconds();
+
+            _test.sink += _test_fixed_path(quantity);
+
+            float_seconds += middle - start;
+            fixed_seconds += _test_seconds() - middle;
+        }
+
+        printf("value: %-12s float %6.1f ns, fixed %6.1f ns per value\n", quantity->name,
+               1e9 * float_seconds / TEST_ROUNDS / TEST_VALUE_COUNT, 1e9 * fixed_seconds / TEST_ROUNDS / TEST_VALUE_COUNT);
+    }
+
+    printf("value: %d failures\n", _test.failures);
+
+    return _test.failures == 0 ? 0 : 1;
+}
+
+// xorshift32, the same walk on every run, uniform in -0.5 to 0.5
+static float _test_random(void)
+{
+    _test.random ^= _test.random << 13;
+    _test.random ^= _test.random >> 17;
+    _test.random ^= _test.random << 5;
+
+    return (float) (_test.random & 0xffff) / 0xffff - 0.5f;
+}
+
+static double _test_seconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Before: fabs against the last published float, printf rounding of the float
+static int _test_float_path(const test_quantity_t *quantity)
+{
+    char buffer[TEST_TEXT_LENGTH];
+    float published = NAN;
+    int count = 0;
+
+    for (int i = 0; i < TEST_VALUE_COUNT; i++)
+    {
+        float number = _test.number[i];
+
+        if (isnan(published) || (fabsf(number - published) >= quantity->change))
+        {
+            published = number;
+
+            count += snprintf(buffer, sizeof(buffer), "%.*f", quantity->decimals, number);
+        }
+    }
+
+    return count;
+}
+
+// After: one conversion at the SDK boundary, integer distance and formatting
+static int _test_fixed_path(const test_quantity_t *quantity)
+{
+    char buffer[TEST_TEXT_LENGTH];
+    int32_t change = VALUE_FIXED(quantity->change, quantity->decimals);
+    value_t published = { 0 };
+    bool first = true;
+    int count = 0;
+
+    for (int i = 0; i < TEST_VALUE_COUNT; i++)
+    {
+        value_t value = value_from_float(_test.number[i], quantity->decimals, quantity->unit);
+
+        if (first || (value_distance(&value, &published) >= change))
+        {
+            published = value;
+            first = false;
+
+            count += value_format(buffer, sizeof(buffer), &value);
+        }
+    }
+
+    return count;
+}
+
+// Both decisions and both texts for every value against the reference the float path published last,
+// they may only differ where the float distance is within one LSB of the threshold or the value is a tie
+static void _test_compare(const test_quantity_t *quantity)
+{
+    char text[2][TEST_TEXT_LENGTH];
+    int32_t change = VALUE_FIXED(quantity->change, quantity->decimals);
+    float lsb = 1.0f / VALUE_SCALE(quantity->decimals);
+    float published = _test.number[0];
+    int count = 0;
+    int boundaries = 0;
+    int ties = 0;
+
+    for (int i = 1; i < TEST_VALUE_COUNT; i++)
+    {
+        float number = _test.number[i];
+        value_t value = value_from_float(number, quantity->decimals, quantity->unit);
+        value_t reference = value_from_float(published, quantity->decimals, quantity->unit);
+        bool float_publish = fabsf(number - published) >= quantity->change;
+        bool fixed_publish = value_distance(&value, &reference) >= change;
+
+        if (float_publish != fixed_publish)
+        {
+            if (fabsf(fabsf(number - published) - quantity->change) > lsb * 1.01f)
+            {
+                printf("value: %s: %f against %f decided differently\n", quantity->name, number, published);
+
+                _test.failures++;
+            }
+
+            boundaries++;
+        }
+
+        if (!float_publish)
+        {
+            continue;
+        }
+
+        published = number;
+
+        snprintf(text[0], sizeof(text[0]), "%.*f", quantity->decimals, number);
+        value_format(text[1], sizeof(text[1]), &value);
+
+        if (strcmp(text[0], text[1]) != 0)
+        {
+            if (fabs(strtod(text[0], NULL) - strtod(text[1], NULL)) > lsb * 1.01f)
+            {
+                printf("value: %s: %f formatted as %s and %s\n", quantity->name, number, text[0], text[1]);
+
+                _test.failures++;
+            }
+
+            ties++;
+        }
+
+        count++;
+    }
+
+    printf("value: %-12s %d values, %d published, %d decided differently at the threshold, %d rounded differently at a tie\n",
+           quantity->name, TEST_VALUE_COUNT, count, boundaries, ties);
+}
@@ -0,0 +1,123 @@
+# Sums the .data and .bss input sections of a GNU ld map per module and prints the RAM_MAP table ram.c publishes.
+# Application objects are named after their source file, SDK objects (or their host fakes) count as sdk,
+# library archives by their name. Input sections listed in skip (space separated) are left out.
+#
+#   awk -v skip=".bss._host_sram" -f tools/ram_map.awk firmware.map > ram_map.h
+
+function module(file,    name)
+{
+    name = file
+
+    if (name ~ /\(/)
+    {
+        sub(/\(.*$/, "", name)
+        sub(/^.*\//, "", name)
+        sub(/\.a$/, "", name)
+
+        return name
+    }
+
+    if (name ~ /(^|\/)app\/[^\/]+\.o$/)
+    {
+        sub(/^.*\//, "", name)
+        sub(/\.o$/, "", name)
+        gsub(/_/, "-", name)
+
+        return name
+    }
+
+    if (name ~ /(^|\/)(sdk|host)\//)
+    {
+        return "sdk"
+    }
+
+    return "runtime"
+}
+
+function add(section, size, file)
+{
+    if ((output != ".data") && (output != ".bss"))
+    {
+        return
+    }
+
+    if (section in skipped)
+    {
+        return
+    }
+
+    size = strtonum_(size)
+
+    if (size > 0)
+    {
+        ram[module(file)] += size
+    }
+}
+
+# Portable hex parsing, not every awk has strtonum
+function strtonum_(hex,    value, digit, i)
+{
+    value = 0
+    hex = tolower(hex)
+    sub(/^0x/, "", hex)
+
+    for (i = 1; i <= length(hex); i++)
+    {
+        digit = index("0123456789abcdef", substr(hex, i, 1)) - 1
+        value = value * 16 + digit
+    }
+
+    return value
+}
+
+BEGIN { split(skip, list, " "); for (i in list) skipped[list[i]] = 1 }
+
+/^Linker script and memory map/ { started = 1; next }
+
+!started { next }
+
+# Output section, alone on its line when the name is long
+/^\.[^ ]/ { output = $1; pending = ""; next }
+
+# Input section with address, size and file on the next line
+/^ [.A-Za-z_][^ ]*$/ && NF == 1 { pending = $1; next }
+
+pending != "" && NF == 3 && $1 ~ /^0x/ { add(pending, $2, $3); pending = ""; next }
+
+/^ [.A-Za-z_]/ && NF >= 4 && $2 ~ /^0x/ { add($1, $3, $4); pending = ""; next }
+
+{ pending = "" }
+
+END {
+    print "// Generated by tools/ram_map.awk from " (FILENAME == "" ? "nothing" : FILENAME) ", bytes of .data and .bss per module"
+    print "#ifndef _RAM_MAP_H"
+    print "#define _RAM_MAP_H"
+    print ""
+    print "#define RAM_MAP \\"
+
+    # Largest first
+    for (;;)
+    {
+        largest = ""
+
+        for (name in ram)
+        {
+            if ((largest == "") || (ram[name] > ram[largest]) || ((ram[name] == ram[largest]) && (name < largest)))
+            {
+                largest = name
+            }
+        }
+
+        if (largest == "")
+        {
+            break
+        }
+
+        printf "    { \"%s\", %d }, \\\n", largest, ram[largest]
+
+        delete ram[largest]
+    }
+
+    print ""
+    print "#endif"
+}